@@ -0,0 +1,81 @@
+#include "audiopack.h"
+#include "resources.h"
+#include <string.h>
+
+static unsigned char *packData = NULL;
+static int packSize = 0;
+static const AudioPackEntry *entries = NULL;
+static const unsigned char *samples = NULL;
+static uint32_t entryCount = 0;
+
+bool LoadAudioPack(const char *fileName)
+{
+    UnloadAudioPack();
+
+    int size = 0;
+    unsigned char *data = LoadFileData(fileName, &size);
+    if (data == NULL) return false;
+
+    AudioPackHeader header;
+    if ((size_t)size < sizeof(header)) goto invalid;
+    memcpy(&header, data, sizeof(header));
+
+    size_t tableEnd = sizeof(header) + (size_t)header.count * sizeof(AudioPackEntry);
+    if (header.magic != AUDIOPACK_MAGIC || header.version != AUDIOPACK_VERSION ||
+        tableEnd > (size_t)size || (size_t)size - tableEnd != header.dataSize) goto invalid;
+
+    packData = data;
+    packSize = size;
+    entries = (const AudioPackEntry *)(data + sizeof(header));
+    samples = data + tableEnd;
+    entryCount = header.count;
+    TraceLog(LOG_INFO, "AUDIOPACK: [%s] %u sounds, %d KB", fileName, entryCount, size / 1024);
+    return true;
+
+invalid:
+    TraceLog(LOG_WARNING, "AUDIOPACK: [%s] Invalid or outdated pack, run 'make audio'", fileName);
+    UnloadFileData(data);
+    return false;
+}
+
+void UnloadAudioPack(void)
+{
+    if (packData != NULL) UnloadFileData(packData);
+    packData = NULL;
+    packSize = 0;
+    entries = NULL;
+    samples = NULL;
+    entryCount = 0;
+}
+
+static Sound LoadSoundFromPack(const char *fileName)
+{
+    for (uint32_t i = 0; i < entryCount; i++) {
+        const AudioPackEntry *entry = &entries[i];
+        if (strncmp(entry->name, fileName, AUDIOPACK_NAME_SIZE) != 0) continue;
+
+        uint64_t bytes = (uint64_t)entry->frameCount * entry->channels * (entry->sampleSize / 8);
+        uint64_t dataSize = (uint64_t)(packSize - (samples - packData));
+        if ((uint64_t)entry->offset + bytes > dataSize) break;
+
+        // Already in the mixer format, LoadSoundFromWave() only copies it
+        Wave wave = {
+            .frameCount = entry->frameCount,
+            .sampleRate = entry->sampleRate,
+            .sampleSize = entry->sampleSize,
+            .channels = entry->channels,
+            .data = (void *)(samples + entry->offset),
+        };
+        return LoadSoundFromWave(wave);
+    }
+
+    return LoadSound(fileName);
+}
+
+Sound LoadPackedSound(const char *fileName)
+{
+    double start = GetTime();
+    Sound sound = LoadSoundFromPack(fileName);
+    TrackSound(fileName, sound, GetTime() - start);
+    return sound;
+}
@@ -0,0 +1,41 @@
+#ifndef AUDIOPACK_H
+#define AUDIOPACK_H
+
+#include <stdint.h>
+#include "raylib.h"
+
+/* AUDIO PACK */
+// Sound effects cooked offline by tools/audiocook into raw PCM already in the
+// mixer's format, so loading is a copy instead of a decode and resample.
+// Layout: AudioPackHeader, count AudioPackEntry, then the sample data.
+
+#define AUDIOPACK_MAGIC 0x4B415041u  // "APAK"
+#define AUDIOPACK_VERSION 1
+#define AUDIOPACK_NAME_SIZE 64
+
+// raylib mixes in 32-bit float stereo; 48 kHz is what most devices run at
+#define AUDIOPACK_SAMPLE_RATE 48000
+#define AUDIOPACK_SAMPLE_SIZE 32
+#define AUDIOPACK_CHANNELS 2
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t dataSize;
+} AudioPackHeader;
+
+typedef struct {
+    char name[AUDIOPACK_NAME_SIZE];  // Path the game loads it by, e.g. "res/sounds/pause.wav"
+    uint32_t offset;                 // From the start of the data block
+    uint32_t frameCount;
+    uint32_t sampleRate;
+    uint16_t sampleSize;
+    uint16_t channels;
+} AudioPackEntry;
+
+bool LoadAudioPack(const char *fileName);
+void UnloadAudioPack(void);                   // Once every sound is loaded, sounds keep their own copy
+Sound LoadPackedSound(const char *fileName);  // Cooked copy if packed, otherwise decodes fileName
+
+#endif // AUDIOPACK_H
@@ -0,0 +1,15 @@
+#ifndef DELTA_H
+#define DELTA_H
+
+#include "stdbool.h"
+
+/* DELTA ENCODING */
+// A delta is a list of runs: [u16 unchanged bytes][u16 literal bytes][literal bytes...]
+// describing how to turn `base` into `current`. Both buffers have the same size.
+
+// Returns encoded size, or -1 if it does not fit in `capacity`
+int DeltaEncode(const void *base, const void *current, int size, unsigned char *out, int capacity);
+// Rebuilds `current` into `out` from `base` and a delta made by DeltaEncode()
+bool DeltaDecode(const void *base, const unsigned char *delta, int deltaSize, void *out, int size);
+
+#endif // DELTA_H
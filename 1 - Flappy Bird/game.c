@@ -1,4 +1,5 @@
 #include "game.h"
+#include "simthread.h"
 #include "raylib.h"
 
 #define MAX(a, b) ((a)>(b)? (a) : (b))
@@ -11,11 +12,18 @@ int gameScreenWidth = 512;
 int gameScreenHeight = 288;
 
 bool isPaused = false;
+bool showDebugOverlay = false;
+bool nativeResolution = false;
+bool threadedSimulation = false;
+
+Arena permanentArena;
+Arena levelArena;
+Arena frameArena;
 Sound pauseSound;
-Texture2D pauseIcon;
+TextureHandle pauseIcon;
 
-Texture2D background;
-Texture2D ground;
+TextureHandle background;
+TextureHandle ground;
 float backgroundScroll = 0.0f;
 float groundScroll = 0.0f;
 
@@ -36,9 +44,9 @@ Bird bird;
 #define PIPE_WIDTH 70
 
 Pipe pipe;
-Pipe pipes[10][2] = {0};
+Pipe pipes[MAX_PIPES][2] = {0};
 int pipesCount = 0;
-Texture2D pipeTexture;
+TextureHandle pipeTexture;
 float spawnTimer = 0.0f;
 float pipeSpawnInterval = 2.0f;
 int pipeGapHeight;
@@ -48,9 +56,8 @@ int lastY;
 int score;
 
 GameState currentState = STATE_TITLE;
-Font smallFont;
-Font mediumFont;
-Font flappyFont;
+FontHandle smallFont;
+FontHandle flappyFont;
 
 float COUNTDOWN_TIME = 0.75f;
 int count;
@@ -60,171 +67,324 @@ Sound jumpSound;
 Sound scoreSound;
 Sound explosionSound;
 Sound hurtSound;
-Music music;
 
-Texture2D medalBronze;
-Texture2D medalSilver;
-Texture2D medalGold;
+TextureHandle medalBronze;
+TextureHandle medalSilver;
+TextureHandle medalGold;
+
+unsigned int rngState = 1;
+
+GameSnapshot quickSave;
+bool hasQuickSave = false;
 
-int main(void) {
+GameSnapshot spectatorFrame;
+GameSnapshot renderFrame;  // What this frame draws
+
+int main(int argc, char *argv[]) {
     SetTraceLogLevel(LOG_ALL);
 
+    if (!InitArenas()) {
+        TraceLog(LOG_ERROR, "ARENA: Could not reserve %d KB", PERMANENT_ARENA_SIZE / 1024);
+        return 1;
+    }
+
+    // One worker per spare core, for decoding assets at startup
+    InitJobs(-1);
+
+    SpectatorConfig spectatorConfig;
+    bool spectator = ParseSpectatorArgs(argc, argv, &spectatorConfig);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--native") == 0) nativeResolution = true;
+        if (strcmp(argv[i], "--threaded") == 0) threadedSimulation = true;
+    }
+
     /* Initialization: Set up the window and load game resources. */
     SetConfigFlags(FLAG_VSYNC_HINT | FLAG_WINDOW_RESIZABLE);
     InitWindow(screenWidth, screenHeight, "Flappy Bird");
 
     InitAudioDevice();
 
-    // Pause
-    pauseSound = LoadSound("res/pause.mp3");
-    pauseIcon = LoadTexture("res/pause.png");
+    InitHighScores("highscores.dat");
 
-    // Retro Fonts
-    smallFont = LoadFont("res/font.ttf");
-    mediumFont = LoadFontEx("res/flappy.ttf", 14, 0, 0);
-    flappyFont = LoadFontEx("res/flappy.ttf", 28, 0, 0);
+    // Sound effects, cooked into res/sounds.pak by 'make audio' (falls back to the originals)
+    LoadAudioPack("res/sounds.pak");
 
-    // Sounds / Music
-    jumpSound = LoadSound("res/jump.wav");
-    scoreSound = LoadSound("res/score.wav");
-    explosionSound = LoadSound("res/explosion.wav");
-    hurtSound = LoadSound("res/hurt.wav");
-    music = LoadMusicStream("res/marios_way.mp3");
+    // Textures, cooked into res/textures.pak by 'make textures' (falls back to the PNGs)
+    LoadTexturePack("res/textures.pak");
+    const char *textureFiles[] = {
+        "res/pause.png", "res/flat_medal3.png", "res/flat_medal2.png", "res/flat_medal1.png",
+        "res/background.png", "res/ground.png", "res/pipe.png",
+    };
+    TextureHandle textures[7];
+    AcquireTextures(textures, textureFiles, 7);  // Decoded on the job threads, uploaded here
+    pauseIcon = textures[0];
+    medalBronze = textures[1];
+    medalSilver = textures[2];
+    medalGold   = textures[3];
+    background = textures[4];
+    ground = textures[5];
+    pipeTexture = textures[6];
 
-    // Start music
-    music.looping = true;
-    PlayMusicStream(music);
+    // Pause
+    pauseSound = LoadPackedSound("res/pause.mp3");
 
-    // Medals
-    medalBronze = LoadTexture("res/flat_medal3.png");
-    medalSilver = LoadTexture("res/flat_medal2.png");
-    medalGold   = LoadTexture("res/flat_medal1.png");
+    // Retro Fonts, every size from one SDF atlas per typeface
+    smallFont = AcquireFont("res/font.ttf");
+    flappyFont = AcquireFont("res/flappy.ttf");
+
+    // Sounds / Music
+    jumpSound = LoadPackedSound("res/jump.wav");
+    scoreSound = LoadPackedSound("res/score.wav");
+    explosionSound = LoadPackedSound("res/explosion.wav");
+    hurtSound = LoadPackedSound("res/hurt.wav");
+    UnloadAudioPack();
+
+    // Voices per sound, enough to overlap a burst of the same event
+    AddVoices(pauseSound, 1, VOICE_PRIORITY_HIGH);
+    AddVoices(jumpSound, 4, VOICE_PRIORITY_NORMAL);
+    AddVoices(scoreSound, 3, VOICE_PRIORITY_NORMAL);
+    AddVoices(explosionSound, 2, VOICE_PRIORITY_HIGH);
+    AddVoices(hurtSound, 2, VOICE_PRIORITY_HIGH);
+
+    // Start music, streamed on its own thread
+    if (InitMusicThread("res/marios_way.mp3", true))
+        QueueMusicCommand(MUSIC_PLAY, 0.0f);
 
     // Render texture initialization, used to hold the rendering result so we can easily resize it
-    RenderTexture2D target = LoadRenderTexture(gameScreenWidth, gameScreenHeight);
-    SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);  // Texture scale filter to use
-
-    background = LoadTexture("res/background.png");
-    ground = LoadTexture("res/ground.png");
-    pipeTexture = LoadTexture("res/pipe.png");
-    srand(time(NULL));
-    lastY = -PIPE_HEIGHT + rand() % 80 + 20;
+    RenderTexture2D target = { 0 };
+    if (!nativeResolution) {
+        target = LoadRenderTexture(gameScreenWidth, gameScreenHeight);
+        SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);  // Texture scale filter to use
+    }
+
+    SeedRandom((unsigned int)time(NULL));
+    lastY = -PIPE_HEIGHT + RandomValue(20, 99);
     score = 0;
     count = 0;
     timer = 0.0f;
 
     InitBird(&bird);
+    UnloadTexturePack();
 
-    SetTargetFPS(60);
+    // GetTime() counts from InitWindow(), the per-asset times are logged as they load
+    TraceLog(LOG_INFO, "STARTUP: Ready %.1f ms after opening the window", GetTime() * 1000.0);
 
-    while (!WindowShouldClose()) {
+    if (spectator && !InitSpectator(&spectatorConfig, sizeof(GameSnapshot)))
+        TraceLog(LOG_WARNING, "SPECTATOR: Failed to start");
 
+    // Threaded, frames are drawn at the display's rate between the fixed-rate ticks
+    int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+    InitFramePacing((threadedSimulation && refreshRate > 0) ? refreshRate : 60);
+
+    while (!WindowShouldClose()) {
+        BeginPacedFrame();
         UpdateDrawFrame(target);
+        EndPacedFrame();
     }
 
     /* De-Initialization: Clean up resources and close the window. */
-    UnloadTexture(background);
-    UnloadTexture(ground);
-    UnloadTexture(pipeTexture);
-    UnloadTexture(bird.image);
-    UnloadFont(smallFont);
-    UnloadFont(mediumFont);
-    UnloadFont(flappyFont);
+    StopSimThread();
+    LogResourceReport();
+    UnloadResources();
+    UnloadVoices();
     UnloadSound(jumpSound);
     UnloadSound(scoreSound);
     UnloadSound(explosionSound);
     UnloadSound(hurtSound);
-    UnloadMusicStream(music);
-    UnloadTexture(medalBronze);
-    UnloadTexture(medalSilver);
-    UnloadTexture(medalGold);
+    CloseMusicThread();
+
+    CloseSpectator();
+    CloseHighScores();
+    CloseJobs();
 
     CloseWindow(); // Close window and OpenGL context
 
+    UnloadArenas();
+
     return 0;
 }
 
+// Largest whole-number zoom that fits the window, centred on a whole pixel,
+// so every virtual pixel covers the same square of screen pixels
+static Camera2D NativeCamera(void)
+{
+    int zoom = MIN(GetScreenWidth() / gameScreenWidth, GetScreenHeight() / gameScreenHeight);
+    if (zoom < 1) zoom = 1;
+
+    return (Camera2D){
+        .offset = { (float)((GetScreenWidth() - gameScreenWidth*zoom) / 2), (float)((GetScreenHeight() - gameScreenHeight*zoom) / 2) },
+        .zoom = (float)zoom,
+    };
+}
+
+// The whole frame in virtual screen coordinates, for either render path
+static void DrawScene(const GameSnapshot *state)
+{
+    if (state->state == STATE_TITLE)
+        DrawTitle(state);
+    else if (state->state == STATE_PLAY)
+        DrawGame(state);
+    else if (state->state == STATE_SCORE)
+        DrawScore(state);
+    else if (state->state == STATE_COUNTDOWN)
+        DrawCountdown(state);
+    else if (state->state == STATE_HIGH_SCORES)
+        DrawHighScores(state);
+
+    // Nothing updates while paused, so the frame under the icon is the one it was paused on
+    if (isPaused)
+    {
+        // DrawRectangle(0, 0, gameScreenWidth, gameScreenHeight, Fade(BLACK, 0.6f));
+
+        float scale = 0.09f; // Adjust size to 50%
+        Texture2D icon = GetTexture(pauseIcon);
+        int iconWidth = (int)(icon.width * scale);
+        int iconHeight = (int)(icon.height * scale);
+        Vector2 position = {
+            (gameScreenWidth - iconWidth) / 2.0f,
+            (gameScreenHeight - iconHeight) / 2.0f
+        };
+
+        DrawTextureEx(icon, position, 0.0f, scale, WHITE);
+    }
+
+    if (GetSpectatorMode() != SPECTATOR_OFF)
+        DrawSpectatorStatus();
+    if (showDebugOverlay)
+        DrawDebugOverlay();
+}
+
+// What the simulation does outside the game state always happens on the main thread
+static void ApplySimEvent(SimEvent event)
+{
+    switch (event.type) {
+        case SIM_EVENT_SOUND: PlayVoice(event.sound); break;
+        case SIM_EVENT_SCORE: SubmitHighScore(event.score, 0); break;
+        case SIM_EVENT_RUN_START: ResetArena(&levelArena); break;
+    }
+}
+
+// Applied at once when the simulation runs here, queued when it has its own thread
+static void EmitSimEvent(SimEvent event)
+{
+    if (IsSimThreadRunning()) PostSimEvent(event);
+    else ApplySimEvent(event);
+}
+
+static void PlaySimSound(Sound sound)
+{
+    EmitSimEvent((SimEvent){ .type = SIM_EVENT_SOUND, .sound = sound });
+}
+
 void UpdateDrawFrame(RenderTexture2D target)
 {
-    if (IsKeyPressed(KEY_P)) {
+    bool spectating = GetSpectatorMode() == SPECTATOR_CLIENT;
+
+    if (IsKeyPressed(KEY_P) && !spectating) {
         isPaused = !isPaused;
-        PlaySound(pauseSound);
+        PlayVoice(pauseSound);
 
-        if (isPaused) PauseMusicStream(music);
-        else ResumeMusicStream(music);
+        QueueMusicCommand(isPaused ? MUSIC_PAUSE : MUSIC_RESUME, 0.0f);
     }
 
-    float deltaTime = GetFrameTime();
-    // Compute required framebuffer scaling
-    float scale = MIN((float)GetScreenWidth()/gameScreenWidth, (float)GetScreenHeight()/gameScreenHeight);
-
-    UpdateMusicStream(music);
-
-    if (!isPaused) {
-        switch (currentState) {
-            case STATE_TITLE:
-                ScrollingBackground(deltaTime);
-                if (IsKeyPressed(KEY_ENTER)) {
-                    currentState = STATE_COUNTDOWN;
-                    ResetGame();
-                }
-                break;
-            case STATE_PLAY:
-                GameLogic(deltaTime);
-                break;
-            case STATE_SCORE:
-                ScrollingBackground(deltaTime);
-                if (IsKeyPressed(KEY_ENTER)) {
-                    currentState = STATE_COUNTDOWN;
-                    ResetGame();
-                }
-                break;
-            case STATE_COUNTDOWN:
-                ScrollingBackground(deltaTime);
-                timer += deltaTime;
-                if (timer > COUNTDOWN_TIME) {
-                    timer = fmod(timer, COUNTDOWN_TIME);
-                    count--;
-
-                    if (count == 0)
-                        currentState = STATE_PLAY;
-                }
-        }
+    if (IsKeyPressed(KEY_F3)) showDebugOverlay = !showDebugOverlay;
+    if (IsKeyPressed(KEY_F4)) LogResourceReport();
+
+    // Quick save / quick load; loading takes the game state back from the simulation thread
+    if (IsKeyPressed(KEY_F5) && !spectating && renderFrame.state == STATE_PLAY) {
+        if (IsSimThreadRunning()) quickSave = AcquireSimFrame()->latest;
+        else SaveState(&quickSave);
+        hasQuickSave = true;
+    }
+    if (IsKeyPressed(KEY_F9) && !spectating && hasQuickSave) {
+        StopSimThread();
+        LoadState(&quickSave);
     }
 
-    BeginTextureMode(target);
-        if (isPaused)
-        {
-            // DrawRectangle(0, 0, gameScreenWidth, gameScreenHeight, Fade(BLACK, 0.6f));
+    float deltaTime = GetPacedFrameTime();
 
-            float scale = 0.09f; // Adjust size to 50%
-            int iconWidth = (int)(pauseIcon.width * scale);
-            int iconHeight = (int)(pauseIcon.height * scale);
-            Vector2 position = {
-                (gameScreenWidth - iconWidth) / 2.0f,
-                (gameScreenHeight - iconHeight) / 2.0f
-            };
+    UpdateVoices();
 
-            DrawTextureEx(pauseIcon, position, 0.0f, scale, WHITE);
+    if (spectating) {
+        if (ReceiveSnapshot(&spectatorFrame)) LoadState(&spectatorFrame);
+    } else if (threadedSimulation && !isPaused && (IsSimThreadRunning() || StartSimThread())) {
+        SendSimInput(ReadBirdInput());
+    } else {
+        // Without the thread a tick runs per drawn frame again, so frames go back to the tick rate;
+        // this frame already steps below, its input included
+        if (threadedSimulation && !isPaused) {
+            threadedSimulation = false;
+            InitFramePacing(SIM_TICK_RATE);
         }
-        else if (currentState == STATE_TITLE)
-            DrawTitle();
-        else if (currentState == STATE_PLAY)
-            DrawGame();
-        else if (currentState == STATE_SCORE)
-            DrawScore();
-        else if (currentState == STATE_COUNTDOWN)
-            DrawCountdown();
-    EndTextureMode();
-
-    BeginDrawing();
-        ClearBackground(WHITE);     // Clear screen background
-
-        // Draw render texture to screen, properly scaled
-        DrawTexturePro(target.texture, (Rectangle){ 0.0f, 0.0f, (float)target.texture.width, (float)-target.texture.height },
-                       (Rectangle){ (GetScreenWidth() - ((float)gameScreenWidth*scale))*0.5f, (GetScreenHeight() - ((float)gameScreenHeight*scale))*0.5f,
-                       (float)gameScreenWidth*scale, (float)gameScreenHeight*scale }, (Vector2){ 0, 0 }, 0.0f, WHITE);
-    EndDrawing();
+
+        // Paused, the thread hands the state back until play resumes
+        StopSimThread();
+        if (!isPaused) SimulateTick(ReadBirdInput(), deltaTime);
+    }
+
+    SimEvent event;
+    while (PollSimEvent(&event)) ApplySimEvent(event);
+
+    // The newest two ticks blended to the present, or the state as it stands
+    if (IsSimThreadRunning()) {
+        const SimFrame *frame = AcquireSimFrame();
+        float t = (float)((GetTime() - frame->time) * SIM_TICK_RATE);
+        InterpolateState(&renderFrame, &frame->previous, &frame->latest, Clamp(t, 0.0f, 1.0f));
+        if (GetSpectatorMode() == SPECTATOR_SERVER) BroadcastSnapshot(&frame->latest);
+    } else {
+        SaveState(&renderFrame);
+        if (GetSpectatorMode() == SPECTATOR_SERVER) BroadcastSnapshot(&renderFrame);
+    }
+
+    // Paused nothing moves until a key is pressed, so wait for one instead of redrawing
+    // the same frame; spectator streams have to keep polling
+    SetFrameIdle(isPaused && GetSpectatorMode() == SPECTATOR_OFF);
+
+    if (nativeResolution) {
+        Camera2D camera = NativeCamera();
+        BeginDrawing();
+            ClearBackground(WHITE);     // Letterbox bars
+
+            BeginScissorMode((int)camera.offset.x, (int)camera.offset.y,
+                             gameScreenWidth*(int)camera.zoom, gameScreenHeight*(int)camera.zoom);
+            BeginMode2D(camera);
+                DrawScene(&renderFrame);
+            EndMode2D();
+            EndScissorMode();
+        EndDrawing();
+    } else {
+        // Compute required framebuffer scaling
+        float scale = MIN((float)GetScreenWidth()/gameScreenWidth, (float)GetScreenHeight()/gameScreenHeight);
+
+        BeginTextureMode(target);
+            DrawScene(&renderFrame);
+        EndTextureMode();
+
+        BeginDrawing();
+            ClearBackground(WHITE);     // Clear screen background
+
+            // Draw render texture to screen, properly scaled
+            DrawTexturePro(target.texture, (Rectangle){ 0.0f, 0.0f, (float)target.texture.width, (float)-target.texture.height },
+                           (Rectangle){ (GetScreenWidth() - ((float)gameScreenWidth*scale))*0.5f, (GetScreenHeight() - ((float)gameScreenHeight*scale))*0.5f,
+                           (float)gameScreenWidth*scale, (float)gameScreenHeight*scale }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        EndDrawing();
+    }
+
+    ResetArena(&frameArena);
+}
+
+bool InitArenas()
+{
+    return InitArena(&permanentArena, PERMANENT_ARENA_SIZE) &&
+           InitSubArena(&levelArena, &permanentArena, LEVEL_ARENA_SIZE) &&
+           InitSubArena(&frameArena, &permanentArena, FRAME_ARENA_SIZE);
+}
+
+void UnloadArenas()
+{
+    UnloadArena(&frameArena);
+    UnloadArena(&levelArena);
+    UnloadArena(&permanentArena);
 }
 
 void ScrollingBackground(float dt)
@@ -235,17 +395,175 @@ void ScrollingBackground(float dt)
     // scroll ground by preset speed * dt, looping back to 0 after the screen width passes
     groundScroll = fmodf((groundScroll + GROUND_SCROLL_SPEED * dt), GROUND_LOOPING_POINT);
 }
-void GameLogic(float dt)
+void SaveState(GameSnapshot *snapshot)
+{
+    snapshot->magic = SAVESTATE_MAGIC;
+    snapshot->version = SAVESTATE_VERSION;
+    snapshot->size = sizeof(GameSnapshot);
+    snapshot->state = currentState;
+    snapshot->bird = bird;
+    memcpy(snapshot->pipes, pipes, sizeof(pipes));
+    snapshot->pipesCount = pipesCount;
+    snapshot->spawnTimer = spawnTimer;
+    snapshot->pipeSpawnInterval = pipeSpawnInterval;
+    snapshot->pipeGapHeight = pipeGapHeight;
+    snapshot->lastY = lastY;
+    snapshot->score = score;
+    snapshot->backgroundScroll = backgroundScroll;
+    snapshot->groundScroll = groundScroll;
+    snapshot->count = count;
+    snapshot->timer = timer;
+    snapshot->rngState = rngState;
+}
+
+bool LoadState(const GameSnapshot *snapshot)
+{
+    if (snapshot->magic != SAVESTATE_MAGIC || snapshot->version != SAVESTATE_VERSION ||
+        snapshot->size != sizeof(GameSnapshot)) {
+        TraceLog(LOG_WARNING, "SAVESTATE: Snapshot version or layout mismatch, ignored");
+        return false;
+    }
+    // Spectators load what a server sends, so the counts the game loops over or prints are checked too
+    if (snapshot->state < STATE_TITLE || snapshot->state > STATE_HIGH_SCORES ||
+        snapshot->pipesCount < 0 || snapshot->pipesCount > MAX_PIPES ||
+        snapshot->count < 0 || snapshot->count > COUNTDOWN_SECONDS) {
+        TraceLog(LOG_WARNING, "SAVESTATE: Snapshot holds out-of-range values, ignored");
+        return false;
+    }
+
+    currentState = snapshot->state;
+    // texture handles are resources, not state; keep the ones we hold
+    TextureHandle birdImage = bird.image;
+    bird = snapshot->bird;
+    bird.image = birdImage;
+    memcpy(pipes, snapshot->pipes, sizeof(pipes));
+    for (int i = 0; i < MAX_PIPES; i++) {
+        pipes[i][0].image = pipeTexture;
+        pipes[i][1].image = pipeTexture;
+    }
+    pipesCount = snapshot->pipesCount;
+    spawnTimer = snapshot->spawnTimer;
+    pipeSpawnInterval = snapshot->pipeSpawnInterval;
+    pipeGapHeight = snapshot->pipeGapHeight;
+    lastY = snapshot->lastY;
+    score = snapshot->score;
+    backgroundScroll = snapshot->backgroundScroll;
+    groundScroll = snapshot->groundScroll;
+    count = snapshot->count;
+    timer = snapshot->timer;
+    rngState = snapshot->rngState;
+    return true;
+}
+
+// xorshift32; unlike GetRandomValue() its state is ours to save and restore
+void SeedRandom(unsigned int seed)
+{
+    rngState = seed ? seed : 1;
+}
+
+int RandomValue(int min, int max)
+{
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return min + (int)(rngState % (unsigned int)(max - min + 1));
+}
+
+BirdInput ReadBirdInput()
+{
+    BirdInput input = 0;
+    if (IsKeyPressed(KEY_SPACE) or IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) input |= INPUT_FLAP;
+    if (IsKeyPressed(KEY_ENTER)) input |= INPUT_CONFIRM;
+    if (IsKeyPressed(KEY_H)) input |= INPUT_SCORES;
+    if (IsKeyPressed(KEY_BACKSPACE)) input |= INPUT_BACK;
+    return input;
+}
+
+// One step of the game, on whichever thread owns the state
+void SimulateTick(BirdInput input, float deltaTime)
+{
+    switch (currentState) {
+        case STATE_TITLE:
+            ScrollingBackground(deltaTime);
+            if (input & INPUT_CONFIRM) {
+                currentState = STATE_COUNTDOWN;
+                ResetGame();
+            } else if (input & INPUT_SCORES) {
+                currentState = STATE_HIGH_SCORES;
+            }
+            break;
+        case STATE_PLAY:
+            GameLogic(input, deltaTime);
+            break;
+        case STATE_SCORE:
+            ScrollingBackground(deltaTime);
+            if (input & INPUT_CONFIRM) {
+                currentState = STATE_COUNTDOWN;
+                ResetGame();
+            }
+            break;
+        case STATE_COUNTDOWN:
+            ScrollingBackground(deltaTime);
+            timer += deltaTime;
+            if (timer > COUNTDOWN_TIME) {
+                timer = fmod(timer, COUNTDOWN_TIME);
+                count--;
+
+                if (count == 0)
+                    currentState = STATE_PLAY;
+            }
+            break;
+        case STATE_HIGH_SCORES:
+            ScrollingBackground(deltaTime);
+            if (input & (INPUT_CONFIRM | INPUT_BACK))
+                currentState = STATE_TITLE;
+            break;
+    }
+}
+
+// Scrolls wrap at their looping point, so a tick may have wrapped around
+static float LerpScroll(float from, float to, float t, float period)
+{
+    if (to < from) to += period;
+    return fmodf(from + (to - from) * t, period);
+}
+
+// Positions blended between two consecutive ticks, everything else from the later one
+void InterpolateState(GameSnapshot *out, const GameSnapshot *from, const GameSnapshot *to, float t)
+{
+    *out = *to;
+    out->backgroundScroll = LerpScroll(from->backgroundScroll, to->backgroundScroll, t, BACKGROUND_LOOPING_POINT);
+    out->groundScroll = LerpScroll(from->groundScroll, to->groundScroll, t, GROUND_LOOPING_POINT);
+
+    // A new run puts the bird back and clears the pipes, nothing to blend across that
+    if (from->state != to->state) return;
+
+    out->bird.y = (int)Lerp((float)from->bird.y, (float)to->bird.y, t);
+
+    // Pipes only move left; when the oldest pair leaves, the rest shift down one slot
+    for (int i = 0; i < to->pipesCount; i++) {
+        for (int j = i; j <= i + 1 && j < from->pipesCount; j++) {
+            if (from->pipes[j][0].y != to->pipes[i][0].y) continue;
+
+            float x = Lerp(from->pipes[j][0].x, to->pipes[i][0].x, t);
+            out->pipes[i][0].x = x;
+            out->pipes[i][1].x = x;
+            break;
+        }
+    }
+}
+
+void GameLogic(BirdInput input, float dt)
 {
     ScrollingBackground(dt);
 
     spawnTimer = spawnTimer + dt;
     if (spawnTimer > pipeSpawnInterval)
     {
-        if (pipesCount < 10) {
-            pipeGapHeight = GetRandomValue(80, 120);
+        if (pipesCount < MAX_PIPES) {
+            pipeGapHeight = RandomValue(80, 120);
             // Ensure the top pipe is placed correctly
-            int topPipeY = MAX(-PIPE_HEIGHT + 10, MIN(lastY + GetRandomValue(-20, 20), gameScreenHeight - pipeGapHeight - PIPE_HEIGHT));
+            int topPipeY = MAX(-PIPE_HEIGHT + 10, MIN(lastY + RandomValue(-20, 20), gameScreenHeight - pipeGapHeight - PIPE_HEIGHT));
             lastY = topPipeY;
             // Create top pipe at topPipeY
             pipes[pipesCount][0] = InitPipe(topPipeY, 1);
@@ -254,10 +572,10 @@ void GameLogic(float dt)
             pipesCount++;
         }
         spawnTimer = 0;
-        pipeSpawnInterval = GetRandomValue(15, 25) / 10.0f;
+        pipeSpawnInterval = RandomValue(15, 25) / 10.0f;
     }
 
-    UpdateBird(dt, &bird);
+    UpdateBird(dt, &bird, input);
 
     // collision between bird and pipes
     for (int i = 0; i < pipesCount; ++i)
@@ -268,15 +586,15 @@ void GameLogic(float dt)
         if (CollideBird(&bird, &pipes[i][0]) || CollideBird(&bird, &pipes[i][1]))
         {
             currentState = STATE_SCORE;
-            PlaySound(explosionSound);
-            PlaySound(hurtSound);
+            PlaySimSound(explosionSound);
+            PlaySimSound(hurtSound);
             // ResetGame();
         }
 
         if (not pipes[i][0].scored and ((pipes[i][0].x + PIPE_WIDTH) < bird.x)) {
             score++;
             pipes[i][0].scored = true;
-            PlaySound(scoreSound);
+            PlaySimSound(scoreSound);
         }
 
         if (pipes[i][0].x < -pipes[i][0].width)
@@ -291,138 +609,241 @@ void GameLogic(float dt)
     }
 
     // reset if we get to the ground
-    if (bird.y > gameScreenHeight - ground.height)
+    if (bird.y > gameScreenHeight - GROUND_HEIGHT)
     {
         currentState = STATE_SCORE;
-        PlaySound(explosionSound);
-        PlaySound(hurtSound);
+        PlaySimSound(explosionSound);
+        PlaySimSound(hurtSound);
         // ResetGame();
     }
+
+    if (currentState == STATE_SCORE)
+        EmitSimEvent((SimEvent){ .type = SIM_EVENT_SCORE, .score = score });
 }
 
-void DrawTitle()
+void DrawTitle(const GameSnapshot *state)
 {
     ClearBackground(SKYBLUE);
-    DrawTexture(background, -(int)backgroundScroll, 0, WHITE);
-    DrawTexture(ground, -(int)groundScroll, gameScreenHeight - 16, WHITE);
+    DrawTexture(GetTexture(background), -(int)state->backgroundScroll, 0, WHITE);
+    DrawTexture(GetTexture(ground), -(int)state->groundScroll, gameScreenHeight - GROUND_HEIGHT, WHITE);
 
-    Vector2 titleSize = MeasureTextEx(flappyFont, "Flappy Bird", 28, 0);
+    Vector2 titleSize = MeasureFontText(flappyFont, "Flappy Bird", 28, 0);
     Vector2 titlePos = {
         (gameScreenWidth - titleSize.x) / 2,
         64
     };
-    DrawTextEx(flappyFont, "Flappy Bird", titlePos, 28, 0, WHITE);
+    DrawFontText(flappyFont, "Flappy Bird", titlePos, 28, 0, WHITE);
 
-    Vector2 promptSize = MeasureTextEx(mediumFont, "Press Enter", 14, 0);
+    Vector2 promptSize = MeasureFontText(flappyFont, "Press Enter", 14, 0);
     Vector2 promptPos = {
         (gameScreenWidth - promptSize.x) / 2,
         100
     };
-    DrawTextEx(mediumFont, "Press Enter", promptPos, 14, 0, WHITE);
+    DrawFontText(flappyFont, "Press Enter", promptPos, 14, 0, WHITE);
+
+    Vector2 scoresSize = MeasureFontText(flappyFont, "H - High Scores", 14, 0);
+    Vector2 scoresPos = {
+        (gameScreenWidth - scoresSize.x) / 2,
+        120
+    };
+    DrawFontText(flappyFont, "H - High Scores", scoresPos, 14, 0, WHITE);
 }
 
-void DrawScore()
+void DrawScore(const GameSnapshot *state)
 {
     ClearBackground(SKYBLUE);
-    DrawTexture(background, -(int)backgroundScroll, 0, WHITE);
-    DrawTexture(ground, -(int)groundScroll, gameScreenHeight - 16, WHITE);
+    DrawTexture(GetTexture(background), -(int)state->backgroundScroll, 0, WHITE);
+    DrawTexture(GetTexture(ground), -(int)state->groundScroll, gameScreenHeight - GROUND_HEIGHT, WHITE);
 
-    Vector2 scoreSize = MeasureTextEx(flappyFont, "Oof! You lost!", 28, 0);
+    Vector2 scoreSize = MeasureFontText(flappyFont, "Oof! You lost!", 28, 0);
     Vector2 scorePos = {
         (gameScreenWidth - scoreSize.x) / 2,
         64
     };
-    DrawTextEx(flappyFont, "Oof! You lost!", scorePos, 28, 0, WHITE);
+    DrawFontText(flappyFont, "Oof! You lost!", scorePos, 28, 0, WHITE);
 
-    Vector2 score1Size = MeasureTextEx(mediumFont, "Score:  ", 14, 0);
+    Vector2 score1Size = MeasureFontText(flappyFont, "Score:  ", 14, 0);
     Vector2 score1Pos = {
         (gameScreenWidth - score1Size.x) / 2,
         100
     };
-    DrawTextEx(mediumFont, TextFormat("Score: %d", score), score1Pos, 14, 0, WHITE);
+    DrawFontText(flappyFont, FrameFormat("Score: %d", state->score), score1Pos, 14, 0, WHITE);
 
-    Vector2 promptSize = MeasureTextEx(mediumFont, "Press Enter to Play Again!", 14, 0);
+    const HighScoreTable *table = GetHighScores();
+    int best = (table->count > 0) ? table->entries[0].score : 0;
+    Vector2 bestPos = { score1Pos.x, 120 };
+    DrawFontText(flappyFont, FrameFormat("Best: %d", best), bestPos, 14, 0, WHITE);
+
+    Vector2 promptSize = MeasureFontText(flappyFont, "Press Enter to Play Again!", 14, 0);
     Vector2 promptPos = {
         (gameScreenWidth - promptSize.x) / 2,
         160
     };
-    DrawTextEx(mediumFont, "Press Enter to Play Again!", promptPos, 14, 0, WHITE);
+    DrawFontText(flappyFont, "Press Enter to Play Again!", promptPos, 14, 0, WHITE);
 
-    Texture2D medalToDraw;
+    TextureHandle medalToDraw = INVALID_TEXTURE;
     bool showMedal = false;
 
-    if (score >= 9) {
+    if (state->score >= 9) {
         medalToDraw = medalGold;
         showMedal = true;
-    } else if (score >= 6) {
+    } else if (state->score >= 6) {
         medalToDraw = medalSilver;
         showMedal = true;
-    } else if (score >= 3) {
+    } else if (state->score >= 3) {
         medalToDraw = medalBronze;
         showMedal = true;
     }
 
     if (showMedal) {
-        int medalX = (gameScreenWidth - medalToDraw.width) / 2;
+        Texture2D medal = GetTexture(medalToDraw);
+        int medalX = (gameScreenWidth - medal.width) / 2;
         int medalY = 180;  // below the score text
-        DrawTexture(medalToDraw, medalX, medalY, WHITE);
+        DrawTexture(medal, medalX, medalY, WHITE);
     }
 
 }
 
-void DrawCountdown()
+void DrawCountdown(const GameSnapshot *state)
 {
     ClearBackground(SKYBLUE);
-    DrawTexture(background, -(int)backgroundScroll, 0, WHITE);
-    DrawTexture(ground, -(int)groundScroll, gameScreenHeight - 16, WHITE);
+    DrawTexture(GetTexture(background), -(int)state->backgroundScroll, 0, WHITE);
+    DrawTexture(GetTexture(ground), -(int)state->groundScroll, gameScreenHeight - GROUND_HEIGHT, WHITE);
 
     char buffer[8];
-    sprintf(buffer, "%d", count);
-    Vector2 countSize = MeasureTextEx(flappyFont, buffer, 28, 0);
+    snprintf(buffer, sizeof(buffer), "%d", state->count);
+    Vector2 countSize = MeasureFontText(flappyFont, buffer, 28, 0);
     Vector2 countPos = {
         (gameScreenWidth - countSize.x) / 2,
         120
     };
-    DrawTextEx(flappyFont, buffer, countPos, 28, 0, WHITE);
+    DrawFontText(flappyFont, buffer, countPos, 28, 0, WHITE);
+}
+
+void DrawHighScores(const GameSnapshot *state)
+{
+    ClearBackground(SKYBLUE);
+    DrawTexture(GetTexture(background), -(int)state->backgroundScroll, 0, WHITE);
+    DrawTexture(GetTexture(ground), -(int)state->groundScroll, gameScreenHeight - GROUND_HEIGHT, WHITE);
+
+    Vector2 titleSize = MeasureFontText(flappyFont, "High Scores", 28, 0);
+    Vector2 titlePos = {
+        (gameScreenWidth - titleSize.x) / 2,
+        24
+    };
+    DrawFontText(flappyFont, "High Scores", titlePos, 28, 0, WHITE);
+
+    const HighScoreTable *table = GetHighScores();
+    for (int i = 0; i < HIGHSCORE_COUNT; i++) {
+        const char *line = (i < table->count) ? FrameFormat("%2d.  %d", i + 1, table->entries[i].score)
+                                               : FrameFormat("%2d.  -", i + 1);
+        DrawFontText(flappyFont, line, (Vector2){ gameScreenWidth / 2 - 40, 64 + i * 18 }, 14, 0, WHITE);
+    }
+
+    Vector2 promptSize = MeasureFontText(flappyFont, "Press Enter", 14, 0);
+    Vector2 promptPos = {
+        (gameScreenWidth - promptSize.x) / 2,
+        250
+    };
+    DrawFontText(flappyFont, "Press Enter", promptPos, 14, 0, WHITE);
+}
+
+void DrawSpectatorStatus()
+{
+    const SpectatorStats *stats = GetSpectatorStats();
+
+    const char *msg;
+    if (GetSpectatorMode() == SPECTATOR_SERVER)
+        msg = FrameFormat("LIVE  %d watching", stats->clients);
+    else if (!stats->connected)
+        msg = "STREAM ENDED";
+    else
+        msg = "SPECTATING";
+
+    Vector2 size = MeasureFontText(smallFont, msg, 8, 0);
+    DrawFontText(smallFont, msg, (Vector2){gameScreenWidth - size.x - 4, 4}, 8, 0, WHITE);
+}
+
+static void DrawArenaLine(const char *name, const Arena *arena, float y)
+{
+    const char *line = FrameFormat("%-9s %5.1f / %3d KB  peak %5.1f  %3d allocs  %d failed", name,
+                                   arena->used / 1024.0f, (int)(arena->capacity / 1024), arena->peak / 1024.0f,
+                                   arena->allocations, arena->failures);
+    DrawFontText(smallFont, line, (Vector2){ 4, y }, 8, 0, WHITE);
+}
+
+static void DrawResourceLines(float y)
+{
+    const ResourceTotals *totals = GetResourceTotals();
+    for (int c = 0; c < RESOURCE_CATEGORY_COUNT; c++) {
+        const char *line = FrameFormat("%-9s %3d assets  cpu %7.1f KB  gpu %7.1f KB", GetResourceCategoryName(c),
+                                       totals[c].count, totals[c].cpuBytes / 1024.0f, totals[c].gpuBytes / 1024.0f);
+        DrawFontText(smallFont, line, (Vector2){ 4, y + c * 10 }, 8, 0, WHITE);
+    }
+
+    const char *names[4];
+    int undrawn = GetUndrawnResources(names, 4);
+    const char *line = FrameFormat("never drawn: %d", undrawn);
+    for (int i = 0; i < undrawn && i < 4; i++) line = FrameFormat("%s %s", line, GetFileName(names[i]));
+    DrawFontText(smallFont, line, (Vector2){ 4, y + RESOURCE_CATEGORY_COUNT * 10 }, 8, 0, WHITE);
 }
 
-void DrawGame()
+void DrawDebugOverlay()
+{
+    float y = gameScreenHeight - 100;
+    DrawResourceLines(y);
+    DrawArenaLine("permanent", &permanentArena, y + 50);
+    DrawArenaLine("level", &levelArena, y + 60);
+    DrawArenaLine("frame", &frameArena, y + 70);
+
+    JobStats jobs = GetJobStats();
+    DrawFontText(smallFont, FrameFormat("jobs      %d threads  %lld run  %lld stolen", jobs.threads, jobs.executed, jobs.stolen),
+                 (Vector2){ 4, y + 80 }, 8, 0, WHITE);
+}
+
+void DrawGame(const GameSnapshot *state)
 {
     ClearBackground(SKYBLUE);
-    DrawTexture(background, -(int)backgroundScroll, 0, WHITE);
+    DrawTexture(GetTexture(background), -(int)state->backgroundScroll, 0, WHITE);
 
     // render all the pipes in scene
-    for (int i = 0; i < pipesCount; ++i)
+    for (int i = 0; i < state->pipesCount; ++i)
     {
-        DrawPipe(&pipes[i][0]);
-        DrawPipe(&pipes[i][1]);
+        DrawPipe(&state->pipes[i][0]);
+        DrawPipe(&state->pipes[i][1]);
     }
 
-    DrawTexture(ground, -(int)groundScroll, gameScreenHeight - 16, WHITE);
+    DrawTexture(GetTexture(ground), -(int)state->groundScroll, gameScreenHeight - GROUND_HEIGHT, WHITE);
 
-    DrawTextEx(flappyFont, TextFormat("Score: %d", score), (Vector2){10, 10}, 28, 0, WHITE);
+    DrawFontText(flappyFont, FrameFormat("Score: %d", state->score), (Vector2){10, 10}, 28, 0, WHITE);
 
-    DrawBird(&bird);
+    DrawBird(&state->bird);
     
 }
 
 void ResetGame(void)
 {
+    EmitSimEvent((SimEvent){ .type = SIM_EVENT_RUN_START });
     // backgroundScroll = 0.0f;
     // groundScroll = 0.0f;
     spawnTimer = 0.0f;
     pipesCount = 0;
     score = 0;
-    lastY = -PIPE_HEIGHT + rand() % 80 + 20;
-    UnloadTexture(bird.image); // could be optimized
-    InitBird(&bird);
-    count = 3;
+    lastY = -PIPE_HEIGHT + RandomValue(20, 99);
+    ResetBird(&bird);
+    count = COUNTDOWN_SECONDS;
     timer = 0.0f;
 }
 
 void InitBird(Bird *bird)
 {
-    bird->image = LoadTexture("res/bird.png");
+    bird->image = AcquireTexture("res/bird.png");
+    ResetBird(bird);
+}
+
+// Position only, the texture stays; this runs on the simulation thread
+void ResetBird(Bird *bird)
+{
     bird->width = 38;
     bird->height = 24;
     bird->x = gameScreenWidth / 2 - (38 / 2);
@@ -430,15 +851,15 @@ void InitBird(Bird *bird)
     bird->dy = 0;
 }
 
-void UpdateBird(float dt, Bird *bird)
+void UpdateBird(float dt, Bird *bird, BirdInput input)
 {
     // apply gravity to velocity
     bird->dy += GRAVITY * dt;
     // add a sudden burst of negative gravity if we hit space
-    if (IsKeyPressed(KEY_SPACE) or IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+    if (input & INPUT_FLAP)
     {
         bird->dy = -5;
-        PlaySound(jumpSound);
+        PlaySimSound(jumpSound);
     }
     // apply current velocity to Y position
     bird->y += bird->dy;
@@ -456,9 +877,9 @@ bool CollideBird(Bird *bird, Pipe *pipe)
     return false;
 }
 
-void DrawBird(Bird *bird)
+void DrawBird(const Bird *bird)
 {
-    DrawTexture(bird->image, bird->x, bird->y, WHITE);
+    DrawTexture(GetTexture(bird->image), bird->x, bird->y, WHITE);
 }
 
 Pipe InitPipe(int y, int flipped)
@@ -479,8 +900,8 @@ void UpdatePipe(float dt, Pipe *pipe)
     pipe->x += pipe->scroll * dt;
 }
 
-void DrawPipe(Pipe *pipe)
+void DrawPipe(const Pipe *pipe)
 {
     float height = pipe->flipped ? -pipe->height : pipe->height;
-    DrawTextureRec(pipe->image, (Rectangle){0, 0, pipe->width, height}, (Vector2){pipe->x, pipe->y}, WHITE);
+    DrawTextureRec(GetTexture(pipe->image), (Rectangle){0, 0, pipe->width, height}, (Vector2){pipe->x, pipe->y}, WHITE);
 }
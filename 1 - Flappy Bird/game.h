@@ -1,3 +1,6 @@
+#ifndef GAME_H
+#define GAME_H
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
@@ -8,30 +11,90 @@
 #include <unistd.h>
 #include <math.h>
 #include <time.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "raylib.h"
 #include "raymath.h"
 
-void UpdateDrawFrame(RenderTexture2D target);
-void GameLogic(float deltaTime);
-void DrawGame(void);
-void DrawTitle(void);
+#include "highscore.h"
+#include "voices.h"
+#include "arena.h"
+#include "jobs.h"
+#include "framepacing.h"
+#include "audiopack.h"
+#include "texpack.h"
+#include "sdffont.h"
+#include "resources.h"
+#include "musicthread.h"
+#include "spectator.h"
+
+/* INPUT */
+// Key presses the simulation reacts to, read by the main thread so the
+// simulation never polls the keyboard itself and can run on another thread
+typedef unsigned char BirdInput;
+#define INPUT_FLAP    0x01  // Space or left click
+#define INPUT_CONFIRM 0x02  // Enter
+#define INPUT_SCORES  0x04  // H
+#define INPUT_BACK    0x08  // Backspace
+
+BirdInput ReadBirdInput(void);
+
+/* MEMORY */
+// One block reserved at startup and split three ways: the frame arena is
+// reset at the end of every UpdateDrawFrame(), the level arena by every
+// ResetGame(), and the rest lives as long as the game
+#define PERMANENT_ARENA_SIZE (64 * 1024)
+#define LEVEL_ARENA_SIZE (16 * 1024)
+#define FRAME_ARENA_SIZE (16 * 1024)
+
+extern Arena permanentArena;
+extern Arena levelArena;
+extern Arena frameArena;
+
+bool InitArenas(void);
+void UnloadArenas(void);
+void DrawDebugOverlay(void);
+
+// Replaces TextFormat(), whose few rotating buffers get overwritten by a busy frame
+#define FrameFormat(...) ArenaFormat(&frameArena, __VA_ARGS__)
+
+/* RENDERING */
+// By default the scene is drawn into a gameScreenWidth x gameScreenHeight
+// render texture that is then scaled to the window. --native draws it
+// straight to the backbuffer instead, through a Camera2D with a whole-number
+// zoom, so there is no offscreen pass; the letterbox bars are whatever lies
+// outside the scissor rectangle.
+extern bool nativeResolution;
+
+// --threaded runs the simulation on its own thread at a fixed rate (see
+// simthread.h) and draws at the display's refresh rate; either way every
+// frame is drawn from a GameSnapshot, never from the live game state
+extern bool threadedSimulation;
+
+#define GROUND_HEIGHT 16
+
+void UpdateDrawFrame(RenderTexture2D target);  // target is unused with nativeResolution
+void SimulateTick(BirdInput input, float deltaTime);
+void GameLogic(BirdInput input, float deltaTime);
 void ScrollingBackground(float deltaTime);
 void ResetGame(void);
-void DrawScore(void);
-void DrawCountdown(void);
+void DrawSpectatorStatus(void);
 
 typedef enum {
     STATE_TITLE,
     STATE_PLAY,
     STATE_SCORE,
-    STATE_COUNTDOWN
+    STATE_COUNTDOWN,
+    STATE_HIGH_SCORES
 } GameState;
 
+#define COUNTDOWN_SECONDS 3
+
 extern GameState currentState;
 
 typedef struct {
-    Texture2D image;
+    TextureHandle image;
     int width;
     int height;
     // position bird in the middle of the screen
@@ -42,11 +105,12 @@ typedef struct {
 } Bird;
 
 void InitBird(Bird *bird);
-void UpdateBird(float dt, Bird *bird);
-void DrawBird(Bird *bird);
+void ResetBird(Bird *bird);
+void UpdateBird(float dt, Bird *bird, BirdInput input);
+void DrawBird(const Bird *bird);
 
 typedef struct {
-    Texture2D image;
+    TextureHandle image;
     int scroll;
     int width;
     int height;
@@ -59,4 +123,46 @@ typedef struct {
 bool CollideBird(Bird *bird, Pipe *pipe);
 Pipe InitPipe(int y, int flipped);
 void UpdatePipe(float dt, Pipe *pipe);
-void DrawPipe(Pipe *pipe);
+void DrawPipe(const Pipe *pipe);
+
+/* SAVE STATE */
+#define MAX_PIPES 10
+#define SAVESTATE_MAGIC 0x50414C46u  // "FLAP"
+#define SAVESTATE_VERSION 2
+
+// Fixed-layout copy of everything the simulation reads or writes,
+// small enough to take every tick
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    GameState state;
+    Bird bird;
+    Pipe pipes[MAX_PIPES][2];
+    int pipesCount;
+    float spawnTimer;
+    float pipeSpawnInterval;
+    int pipeGapHeight;
+    int lastY;
+    int score;
+    float backgroundScroll;
+    float groundScroll;
+    int count;
+    float timer;
+    unsigned int rngState;
+} GameSnapshot;
+
+void SaveState(GameSnapshot *snapshot);
+bool LoadState(const GameSnapshot *snapshot);  // False if it does not fit this build or holds out-of-range values
+void InterpolateState(GameSnapshot *out, const GameSnapshot *from, const GameSnapshot *to, float t);
+
+void DrawGame(const GameSnapshot *state);
+void DrawTitle(const GameSnapshot *state);
+void DrawScore(const GameSnapshot *state);
+void DrawCountdown(const GameSnapshot *state);
+void DrawHighScores(const GameSnapshot *state);
+
+void SeedRandom(unsigned int seed);
+int RandomValue(int min, int max);
+
+#endif // GAME_H
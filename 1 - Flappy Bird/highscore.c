@@ -0,0 +1,181 @@
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L  // fileno(), fsync()
+#endif
+
+#include "highscore.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(_WIN32)
+    #include <io.h>  // _commit()
+    // <windows.h> clashes with raylib.h, declare only what we need
+    __declspec(dllimport) int __stdcall MoveFileExA(const char *lpExistingFileName, const char *lpNewFileName, unsigned long dwFlags);
+    #define MOVEFILE_REPLACE_EXISTING 0x00000001
+    #define MOVEFILE_WRITE_THROUGH    0x00000008
+#else
+    #include <unistd.h>  // fsync()
+#endif
+
+static HighScoreTable table = { 0 };
+static char filePath[256];
+static char tempPath[260];
+
+// Save thread state, guarded by saveLock
+static pthread_t saveThread;
+static pthread_mutex_t saveLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t saveSignal = PTHREAD_COND_INITIALIZER;
+static HighScoreFile pendingFile;
+static bool savePending = false;
+static bool saveQuit = false;
+static bool saveThreadRunning = false;
+
+// FNV-1a, good enough to catch torn or foreign files
+static uint32_t Checksum(const HighScoreFile *file)
+{
+    uint32_t hash = 2166136261u;
+    const unsigned char *bytes = (const unsigned char *)&file->count;
+    for (size_t i = 0; i < sizeof(file->count); i++) hash = (hash ^ bytes[i]) * 16777619u;
+    bytes = (const unsigned char *)file->entries;
+    for (size_t i = 0; i < sizeof(file->entries); i++) hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+static bool LoadTable(void)
+{
+    FILE *f = fopen(filePath, "rb");
+    if (f == NULL) return false;
+
+    HighScoreFile file;
+    size_t read = fread(&file, 1, sizeof(file), f);
+    fclose(f);
+
+    if (read != sizeof(file) || file.magic != HIGHSCORE_MAGIC || file.version != HIGHSCORE_VERSION ||
+        file.count > HIGHSCORE_COUNT || file.checksum != Checksum(&file)) {
+        TraceLog(LOG_WARNING, "HIGHSCORE: [%s] Invalid or corrupted file, starting empty", filePath);
+        return false;
+    }
+
+    memcpy(table.entries, file.entries, sizeof(table.entries));
+    table.count = (int)file.count;
+    return true;
+}
+
+// Write to a temp file, flush it to disk and rename over the old one, so a crash
+// leaves either the previous table or the new one, never a partial file
+static bool WriteTable(const HighScoreFile *file)
+{
+    FILE *f = fopen(tempPath, "wb");
+    if (f == NULL) return false;
+
+    bool ok = fwrite(file, 1, sizeof(*file), f) == sizeof(*file);
+    ok = ok && fflush(f) == 0;
+#if defined(_WIN32)
+    ok = ok && _commit(_fileno(f)) == 0;
+#else
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    fclose(f);
+
+    if (ok) {
+#if defined(_WIN32)
+        ok = MoveFileExA(tempPath, filePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        ok = rename(tempPath, filePath) == 0;
+#endif
+    }
+    if (!ok) remove(tempPath);
+
+    return ok;
+}
+
+static void *SaveThreadMain(void *arg)
+{
+    (void)arg;
+    HighScoreFile file;
+
+    pthread_mutex_lock(&saveLock);
+    for (;;) {
+        while (!savePending && !saveQuit) pthread_cond_wait(&saveSignal, &saveLock);
+        if (!savePending) break;
+
+        file = pendingFile;
+        savePending = false;
+        pthread_mutex_unlock(&saveLock);
+
+        if (!WriteTable(&file)) TraceLog(LOG_WARNING, "HIGHSCORE: [%s] Failed to save", filePath);
+
+        pthread_mutex_lock(&saveLock);
+    }
+    pthread_mutex_unlock(&saveLock);
+
+    return NULL;
+}
+
+void InitHighScores(const char *fileName)
+{
+    snprintf(filePath, sizeof(filePath), "%s", fileName);
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", filePath);
+
+    table.count = 0;
+    if (LoadTable()) TraceLog(LOG_INFO, "HIGHSCORE: [%s] Loaded %d entries", filePath, table.count);
+
+    saveQuit = false;
+    savePending = false;
+    saveThreadRunning = pthread_create(&saveThread, NULL, SaveThreadMain, NULL) == 0;
+    if (!saveThreadRunning) TraceLog(LOG_WARNING, "HIGHSCORE: Failed to start save thread, saving synchronously");
+}
+
+void CloseHighScores(void)
+{
+    if (!saveThreadRunning) return;
+
+    pthread_mutex_lock(&saveLock);
+    saveQuit = true;
+    pthread_cond_signal(&saveSignal);
+    pthread_mutex_unlock(&saveLock);
+
+    pthread_join(saveThread, NULL);
+    saveThreadRunning = false;
+}
+
+int SubmitHighScore(int score, int level)
+{
+    if (score <= 0) return -1;
+
+    // Equal scores keep the older entry first
+    int rank = table.count;
+    while (rank > 0 && table.entries[rank - 1].score < score) rank--;
+    if (rank >= HIGHSCORE_COUNT) return -1;
+
+    int last = (table.count < HIGHSCORE_COUNT) ? table.count : HIGHSCORE_COUNT - 1;
+    memmove(&table.entries[rank + 1], &table.entries[rank], (last - rank) * sizeof(HighScoreEntry));
+    table.entries[rank] = (HighScoreEntry){ .score = score, .level = level };
+    if (table.count < HIGHSCORE_COUNT) table.count++;
+
+    HighScoreFile file = { 0 };
+    file.magic = HIGHSCORE_MAGIC;
+    file.version = HIGHSCORE_VERSION;
+    file.count = (uint32_t)table.count;
+    memcpy(file.entries, table.entries, sizeof(file.entries));
+    file.checksum = Checksum(&file);
+
+    if (saveThreadRunning) {
+        // Only the latest table matters, overwrite any save not yet picked up
+        pthread_mutex_lock(&saveLock);
+        pendingFile = file;
+        savePending = true;
+        pthread_cond_signal(&saveSignal);
+        pthread_mutex_unlock(&saveLock);
+    } else if (!WriteTable(&file)) {
+        TraceLog(LOG_WARNING, "HIGHSCORE: [%s] Failed to save", filePath);
+    }
+
+    return rank;
+}
+
+const HighScoreTable *GetHighScores(void)
+{
+    return &table;
+}
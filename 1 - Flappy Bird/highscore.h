@@ -0,0 +1,36 @@
+#ifndef HIGHSCORE_H
+#define HIGHSCORE_H
+
+#include <stdint.h>
+#include "stdbool.h"
+
+/* HIGH SCORES */
+#define HIGHSCORE_COUNT 10
+#define HIGHSCORE_MAGIC 0x43534948u  // "HISC"
+#define HIGHSCORE_VERSION 1
+
+typedef struct {
+    int32_t score;
+    int32_t level;
+} HighScoreEntry;
+
+// On-disk layout, fixed size; the checksum covers count and entries
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t checksum;
+    HighScoreEntry entries[HIGHSCORE_COUNT];
+} HighScoreFile;
+
+typedef struct {
+    HighScoreEntry entries[HIGHSCORE_COUNT];  // sorted, best first
+    int count;
+} HighScoreTable;
+
+void InitHighScores(const char *fileName);   // Load table and start the save thread
+void CloseHighScores(void);                  // Flush pending save and stop the save thread
+int SubmitHighScore(int score, int level);   // Returns rank (0 is best) or -1 if not in table
+const HighScoreTable *GetHighScores(void);
+
+#endif // HIGHSCORE_H
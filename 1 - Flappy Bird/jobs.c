@@ -0,0 +1,295 @@
+#include "jobs.h"
+#include "raylib.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct {
+    pthread_mutex_t lock;
+    Job jobs[JOB_QUEUE_SIZE];
+    int top;                  // Oldest, thieves take from here
+    int bottom;               // Newest, the owner pushes and pops here
+    atomic_int size;          // Peeked without the lock to skip empty deques
+    atomic_llong executed;
+    atomic_llong stolen;
+} JobQueue;
+
+static JobQueue queues[JOB_MAX_THREADS];
+static pthread_t workers[JOB_MAX_THREADS];
+static pthread_key_t threadKey;
+static int threadCount = 1;        // Deques in use, main thread included
+static int workersStarted = 0;
+static bool initialized = false;
+
+static atomic_bool quit = false;
+static atomic_int queued = 0;     // Jobs sitting in any deque
+static atomic_int sleeping = 0;
+static pthread_mutex_t sleepLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+
+static int CoreCount(void)
+{
+#if defined(_WIN32)
+    return pthread_num_processors_np();
+#else
+    return (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+// The main thread, and any thread that is not a worker, uses deque 0
+static int ThreadIndex(void)
+{
+    if (!initialized) return 0;
+    intptr_t value = (intptr_t)pthread_getspecific(threadKey);
+    return (value > 0) ? (int)value - 1 : 0;
+}
+
+static void LockCounter(JobCounter *counter)
+{
+    while (atomic_flag_test_and_set_explicit(&counter->lock, memory_order_acquire)) sched_yield();
+}
+
+static void UnlockCounter(JobCounter *counter)
+{
+    atomic_flag_clear_explicit(&counter->lock, memory_order_release);
+}
+
+static bool PushJob(Job job)
+{
+    JobQueue *queue = &queues[ThreadIndex()];
+
+    pthread_mutex_lock(&queue->lock);
+    bool room = queue->bottom - queue->top < JOB_QUEUE_SIZE;
+    if (room) {
+        queue->jobs[queue->bottom++ & (JOB_QUEUE_SIZE - 1)] = job;
+        atomic_fetch_add_explicit(&queue->size, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    if (!room) return false;
+
+    // Pairs with the sleeper bumping sleeping before it looks at queued
+    atomic_fetch_add(&queued, 1);
+    if (atomic_load(&sleeping) > 0) {
+        pthread_mutex_lock(&sleepLock);
+        pthread_cond_signal(&wake);
+        pthread_mutex_unlock(&sleepLock);
+    }
+    return true;
+}
+
+static bool PopJob(JobQueue *queue, Job *job, bool oldest)
+{
+    if (atomic_load_explicit(&queue->size, memory_order_relaxed) == 0) return false;
+
+    pthread_mutex_lock(&queue->lock);
+    bool found = queue->bottom != queue->top;
+    if (found) {
+        *job = oldest ? queue->jobs[queue->top++ & (JOB_QUEUE_SIZE - 1)] : queue->jobs[--queue->bottom & (JOB_QUEUE_SIZE - 1)];
+        if (queue->top == queue->bottom) queue->top = queue->bottom = 0;
+        atomic_fetch_sub_explicit(&queue->size, 1, memory_order_relaxed);
+        atomic_fetch_sub(&queued, 1);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return found;
+}
+
+static bool TakeJob(int self, Job *job)
+{
+    if (!initialized) return false;
+    if (PopJob(&queues[self], job, false)) return true;
+
+    for (int i = 1; i < threadCount; i++) {
+        if (PopJob(&queues[(self + i) % threadCount], job, true)) {
+            atomic_fetch_add_explicit(&queues[self].stolen, 1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void Schedule(Job job);
+
+static void FinishJob(JobCounter *counter)
+{
+    Job released[JOB_MAX_DEPENDENTS];
+    int count = 0;
+
+    // Under the lock, so a waiter that sees zero can tell when this thread is done with the counter
+    LockCounter(counter);
+    if (atomic_fetch_sub_explicit(&counter->pending, 1, memory_order_acq_rel) == 1) {
+        count = counter->dependentCount;
+        memcpy(released, counter->dependents, count * sizeof(Job));
+        counter->dependentCount = 0;
+    }
+    UnlockCounter(counter);
+
+    for (int i = 0; i < count; i++) Schedule(released[i]);
+}
+
+static void Execute(int self, Job job)
+{
+    job.function(job.data, job.begin, job.end);
+    if (initialized) atomic_fetch_add_explicit(&queues[self].executed, 1, memory_order_relaxed);
+    if (job.counter != NULL) FinishJob(job.counter);
+}
+
+// Queued, or run right here when there are no deques or this one is full
+static void Schedule(Job job)
+{
+    if (!initialized || !PushJob(job)) Execute(ThreadIndex(), job);
+}
+
+static void *WorkerMain(void *arg)
+{
+    int self = (int)(intptr_t)arg;
+    pthread_setspecific(threadKey, (void *)(intptr_t)(self + 1));
+
+    int idleRounds = 0;
+    while (!atomic_load(&quit)) {
+        Job job;
+        if (TakeJob(self, &job)) {
+            Execute(self, job);
+            idleRounds = 0;
+            continue;
+        }
+
+        // A short spin catches the next batch of a frame without a wake-up
+        if (++idleRounds < JOB_SPIN_ROUNDS) {
+            sched_yield();
+            continue;
+        }
+
+        pthread_mutex_lock(&sleepLock);
+        atomic_fetch_add(&sleeping, 1);
+        while (atomic_load(&queued) == 0 && !atomic_load(&quit)) pthread_cond_wait(&wake, &sleepLock);
+        atomic_fetch_sub(&sleeping, 1);
+        pthread_mutex_unlock(&sleepLock);
+        idleRounds = 0;
+    }
+    return NULL;
+}
+
+bool InitJobs(int workerCount)
+{
+    if (initialized) return true;
+
+    if (workerCount < 0) workerCount = CoreCount() - 1;
+    if (workerCount > JOB_MAX_THREADS - 1) workerCount = JOB_MAX_THREADS - 1;
+    if (workerCount < 0) workerCount = 0;
+
+    if (pthread_key_create(&threadKey, NULL) != 0) {
+        TraceLog(LOG_WARNING, "JOBS: Failed to create thread key, jobs run where they are waited for");
+        return false;
+    }
+    // Every deque exists before a worker can look at it; one whose worker failed to start just stays empty
+    for (int i = 0; i <= workerCount; i++) {
+        pthread_mutex_init(&queues[i].lock, NULL);
+        queues[i].top = queues[i].bottom = 0;
+        atomic_store(&queues[i].size, 0);
+        atomic_store(&queues[i].executed, 0);
+        atomic_store(&queues[i].stolen, 0);
+    }
+    atomic_store(&quit, false);
+    atomic_store(&queued, 0);
+    threadCount = workerCount + 1;
+    workersStarted = 0;
+    initialized = true;
+
+    for (int i = 1; i <= workerCount; i++) {
+        if (pthread_create(&workers[i], NULL, WorkerMain, (void *)(intptr_t)i) != 0) {
+            TraceLog(LOG_WARNING, "JOBS: Only %d of %d workers started", i - 1, workerCount);
+            break;
+        }
+        workersStarted++;
+    }
+
+    TraceLog(LOG_INFO, "JOBS: %d worker threads", workersStarted);
+    return true;
+}
+
+void CloseJobs(void)
+{
+    if (!initialized) return;
+
+    Job job;
+    while (TakeJob(0, &job)) Execute(0, job);
+
+    pthread_mutex_lock(&sleepLock);
+    atomic_store(&quit, true);
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&sleepLock);
+    for (int i = 1; i <= workersStarted; i++) pthread_join(workers[i], NULL);
+
+    // Dependents a worker released on its way out
+    while (TakeJob(0, &job)) Execute(0, job);
+
+    for (int i = 0; i < threadCount; i++) pthread_mutex_destroy(&queues[i].lock);
+    pthread_key_delete(threadKey);
+    threadCount = 1;
+    workersStarted = 0;
+    initialized = false;
+}
+
+void RunJob(JobFunction function, void *data, JobCounter *counter)
+{
+    if (counter != NULL) atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+    Schedule((Job){ function, data, 0, 1, counter });
+}
+
+void RunJobAfter(JobCounter *dependency, JobFunction function, void *data, JobCounter *counter)
+{
+    if (counter != NULL) atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+    Job job = { function, data, 0, 1, counter };
+
+    LockCounter(dependency);
+    bool pending = atomic_load_explicit(&dependency->pending, memory_order_acquire) > 0;
+    bool held = pending && dependency->dependentCount < JOB_MAX_DEPENDENTS;
+    if (held) dependency->dependents[dependency->dependentCount++] = job;
+    UnlockCounter(dependency);
+
+    if (held) return;
+    if (pending) WaitForJobs(dependency);  // No room to hold it back
+    Schedule(job);
+}
+
+void ParallelFor(JobFunction function, void *data, int count, int batch, JobCounter *counter)
+{
+    if (batch < 1) batch = 1;
+    for (int begin = 0; begin < count; begin += batch) {
+        int end = (count - begin > batch) ? begin + batch : count;
+        if (counter != NULL) atomic_fetch_add_explicit(&counter->pending, 1, memory_order_relaxed);
+        Schedule((Job){ function, data, begin, end, counter });
+    }
+}
+
+bool AreJobsDone(JobCounter *counter)
+{
+    if (atomic_load_explicit(&counter->pending, memory_order_acquire) > 0) return false;
+
+    // The last job may still be inside FinishJob(); once the lock is free it has let go
+    LockCounter(counter);
+    UnlockCounter(counter);
+    return true;
+}
+
+void WaitForJobs(JobCounter *counter)
+{
+    int self = ThreadIndex();
+    while (!AreJobsDone(counter)) {
+        Job job;
+        if (TakeJob(self, &job)) Execute(self, job);
+        else sched_yield();  // The rest are running on other threads
+    }
+}
+
+JobStats GetJobStats(void)
+{
+    JobStats stats = { workersStarted + 1, 0, 0 };
+    for (int i = 0; initialized && i < threadCount; i++) {
+        stats.executed += atomic_load_explicit(&queues[i].executed, memory_order_relaxed);
+        stats.stolen += atomic_load_explicit(&queues[i].stolen, memory_order_relaxed);
+    }
+    return stats;
+}
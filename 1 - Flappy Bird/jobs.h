@@ -0,0 +1,61 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdatomic.h>
+#include "stdbool.h"
+
+/* JOBS */
+// One pool of worker threads for every kind of parallel work, instead of a
+// thread per feature. Each thread, the main thread included, has its own
+// deque: it pushes and pops its own jobs at the bottom, newest first while
+// their data is still in cache, and a thread that runs dry steals the oldest
+// job from the top of another's. Idle workers spin briefly, then sleep until
+// a job is pushed.
+//
+// A JobCounter counts the jobs given to it that have not finished yet.
+// Waiting on one runs queued jobs instead of blocking, so the main thread
+// helps with its own work. A job can also be held back until another
+// counter reaches zero, which chains dependent stages without a wait.
+// Counters start zeroed and can be reused once they are done.
+// With no workers, jobs still run: on the thread that waits for them.
+
+#define JOB_MAX_THREADS 64          // Main thread included
+#define JOB_QUEUE_SIZE 256          // Per thread, power of two; a full deque runs the job at once
+#define JOB_MAX_DEPENDENTS 8        // Held back on one counter at a time
+#define JOB_SPIN_ROUNDS 64          // Failed steal rounds before an idle worker sleeps
+
+typedef void (*JobFunction)(void *data, int begin, int end);
+
+struct JobCounter;
+
+typedef struct {
+    JobFunction function;
+    void *data;
+    int begin, end;
+    struct JobCounter *counter;  // Counted down when the job finishes, may be NULL
+} Job;
+
+typedef struct JobCounter {
+    atomic_int pending;
+    atomic_flag lock;            // Guards the finish and the dependents
+    int dependentCount;
+    Job dependents[JOB_MAX_DEPENDENTS];
+} JobCounter;
+
+typedef struct {
+    int threads;                 // Main thread included
+    long long executed;
+    long long stolen;
+} JobStats;
+
+bool InitJobs(int workers);      // Workers besides the main thread, -1 for one per remaining core
+void CloseJobs(void);            // Finishes what is queued, then joins the workers
+
+void RunJob(JobFunction function, void *data, JobCounter *counter);
+void RunJobAfter(JobCounter *dependency, JobFunction function, void *data, JobCounter *counter);
+void ParallelFor(JobFunction function, void *data, int count, int batch, JobCounter *counter);  // Jobs of up to batch items
+void WaitForJobs(JobCounter *counter);       // Runs other jobs until the counter is done
+bool AreJobsDone(JobCounter *counter);
+JobStats GetJobStats(void);
+
+#endif // JOBS_H
@@ -0,0 +1,94 @@
+#include "musicthread.h"
+#include "resources.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+typedef struct {
+    MusicCommandType type;
+    float value;
+} MusicCommand;
+
+static Music music = { 0 };
+static pthread_t musicThread;
+static atomic_bool running = false;
+
+// head is written only by the music thread, tail only by the main thread
+static MusicCommand commands[MUSIC_COMMAND_QUEUE];
+static atomic_uint head = 0;
+static atomic_uint tail = 0;
+
+bool QueueMusicCommand(MusicCommandType type, float value)
+{
+    if (!atomic_load_explicit(&running, memory_order_relaxed)) return false;
+
+    unsigned int t = atomic_load_explicit(&tail, memory_order_relaxed);
+    if (t - atomic_load_explicit(&head, memory_order_acquire) >= MUSIC_COMMAND_QUEUE) {
+        TraceLog(LOG_WARNING, "MUSIC: Command queue full, command dropped");
+        return false;
+    }
+
+    commands[t & (MUSIC_COMMAND_QUEUE - 1)] = (MusicCommand){ type, value };
+    atomic_store_explicit(&tail, t + 1, memory_order_release);
+    return true;
+}
+
+static void ApplyCommand(MusicCommand command)
+{
+    switch (command.type) {
+        case MUSIC_PLAY: PlayMusicStream(music); break;
+        case MUSIC_PAUSE: PauseMusicStream(music); break;
+        case MUSIC_RESUME: ResumeMusicStream(music); break;
+        case MUSIC_STOP: StopMusicStream(music); break;
+        case MUSIC_VOLUME: SetMusicVolume(music, command.value); break;
+    }
+}
+
+static void *MusicThreadMain(void *arg)
+{
+    (void)arg;
+
+    while (atomic_load_explicit(&running, memory_order_acquire)) {
+        unsigned int h = atomic_load_explicit(&head, memory_order_relaxed);
+        unsigned int t = atomic_load_explicit(&tail, memory_order_acquire);
+        for (; h != t; h++) ApplyCommand(commands[h & (MUSIC_COMMAND_QUEUE - 1)]);
+        atomic_store_explicit(&head, h, memory_order_release);
+
+        // Decodes into whichever stream buffers the mixer has already consumed
+        UpdateMusicStream(music);
+        WaitTime(MUSIC_THREAD_INTERVAL);
+    }
+    return NULL;
+}
+
+bool InitMusicThread(const char *fileName, bool looping)
+{
+    // Bigger buffers give the thread more slack than the default of a few device periods
+    SetAudioStreamBufferSizeDefault(MUSIC_STREAM_BUFFER_FRAMES);
+    double start = GetTime();
+    music = LoadMusicStream(fileName);
+    SetAudioStreamBufferSizeDefault(0);
+
+    if (!IsMusicValid(music)) return false;
+    music.looping = looping;
+    TrackMusic(fileName, music, MUSIC_STREAM_BUFFER_FRAMES, GetTime() - start);
+
+    atomic_store(&head, 0);
+    atomic_store(&tail, 0);
+    atomic_store(&running, true);
+    if (pthread_create(&musicThread, NULL, MusicThreadMain, NULL) != 0) {
+        TraceLog(LOG_WARNING, "MUSIC: Failed to start music thread");
+        atomic_store(&running, false);
+        UnloadMusicStream(music);
+        return false;
+    }
+    return true;
+}
+
+void CloseMusicThread(void)
+{
+    if (!atomic_load(&running)) return;
+
+    atomic_store_explicit(&running, false, memory_order_release);
+    pthread_join(musicThread, NULL);
+    UnloadMusicStream(music);
+}
@@ -0,0 +1,28 @@
+#ifndef MUSICTHREAD_H
+#define MUSICTHREAD_H
+
+#include "raylib.h"
+
+/* MUSIC THREAD */
+// The music stream is owned by a background thread that keeps its buffers
+// decoded ahead of the mixer, so a long frame on the main thread cannot starve
+// it. The main thread never touches the Music itself, it only queues commands
+// through a single-producer, single-consumer ring that takes no locks.
+
+#define MUSIC_COMMAND_QUEUE 16                 // Power of two
+#define MUSIC_STREAM_BUFFER_FRAMES 8192        // Per sub-buffer, ~190 ms at 44.1 kHz
+#define MUSIC_THREAD_INTERVAL 0.010            // Seconds between refills
+
+typedef enum {
+    MUSIC_PLAY,
+    MUSIC_PAUSE,
+    MUSIC_RESUME,
+    MUSIC_STOP,
+    MUSIC_VOLUME,
+} MusicCommandType;
+
+bool InitMusicThread(const char *fileName, bool looping);  // Loads the stream and starts the thread
+void CloseMusicThread(void);                               // Joins the thread and unloads the stream
+bool QueueMusicCommand(MusicCommandType type, float value);  // Main thread only; false if the queue is full
+
+#endif // MUSICTHREAD_H
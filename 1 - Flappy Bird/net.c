@@ -0,0 +1,237 @@
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L  // getaddrinfo()
+#endif
+
+#include "net.h"
+#include <string.h>
+
+#if defined(_WIN32)
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    typedef int socklen_t;
+#else
+    #include <sys/types.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <netdb.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+#if defined(MSG_NOSIGNAL)
+    #define NET_SEND_FLAGS MSG_NOSIGNAL  // a vanished peer must not kill us with SIGPIPE
+#else
+    #define NET_SEND_FLAGS 0
+#endif
+
+bool InitNet(void)
+{
+#if defined(_WIN32)
+    WSADATA wsaData;
+    return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+#else
+    return true;
+#endif
+}
+
+void CloseNet(void)
+{
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+}
+
+bool NetResolve(const char *host, int port, NetAddress *address)
+{
+    struct addrinfo hints;
+    struct addrinfo *result = NULL;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(host, NULL, &hints, &result) != 0 || result == NULL) return false;
+
+    address->host = ((struct sockaddr_in *)result->ai_addr)->sin_addr.s_addr;
+    address->port = htons((uint16_t)port);
+    freeaddrinfo(result);
+    return true;
+}
+
+bool NetAddressEqual(NetAddress a, NetAddress b)
+{
+    return a.host == b.host && a.port == b.port;
+}
+
+static bool SetNonBlocking(NetSocket sock)
+{
+#if defined(_WIN32)
+    u_long mode = 1;
+    return ioctlsocket((SOCKET)sock, FIONBIO, &mode) == 0;
+#else
+    int flags = fcntl((int)sock, F_GETFL, 0);
+    return flags != -1 && fcntl((int)sock, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+NetSocket NetOpenUdp(int port)
+{
+#if defined(_WIN32)
+    SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) return NET_INVALID_SOCKET;
+#else
+    int s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s < 0) return NET_INVALID_SOCKET;
+#endif
+    NetSocket sock = (NetSocket)s;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+
+    if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) != 0 || !SetNonBlocking(sock)) {
+        NetCloseSocket(sock);
+        return NET_INVALID_SOCKET;
+    }
+    return sock;
+}
+
+int NetSendTo(NetSocket sock, NetAddress to, const void *data, int size)
+{
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = to.host;
+    addr.sin_port = to.port;
+
+    return (int)sendto(sock, data, size, 0, (struct sockaddr *)&addr, sizeof(addr));
+}
+
+int NetReceiveFrom(NetSocket sock, NetAddress *from, void *data, int size)
+{
+    struct sockaddr_in addr;
+    socklen_t length = sizeof(addr);
+
+    int received = (int)recvfrom(sock, data, size, 0, (struct sockaddr *)&addr, &length);
+    if (received < 0) return -1;
+
+    if (from != NULL) {
+        from->host = addr.sin_addr.s_addr;
+        from->port = addr.sin_port;
+    }
+    return received;
+}
+
+static bool WouldBlock(void)
+{
+#if defined(_WIN32)
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+static void SetNoDelay(NetSocket sock)
+{
+    int on = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char *)&on, sizeof(on));
+}
+
+NetSocket NetListenTcp(int port)
+{
+#if defined(_WIN32)
+    SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == INVALID_SOCKET) return NET_INVALID_SOCKET;
+#else
+    int s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s < 0) return NET_INVALID_SOCKET;
+#endif
+    NetSocket sock = (NetSocket)s;
+
+    int reuse = 1;
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char *)&reuse, sizeof(reuse));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+
+    if (bind(s, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(s, 16) != 0 || !SetNonBlocking(sock)) {
+        NetCloseSocket(sock);
+        return NET_INVALID_SOCKET;
+    }
+    return sock;
+}
+
+NetSocket NetAccept(NetSocket listener)
+{
+#if defined(_WIN32)
+    SOCKET s = accept((SOCKET)listener, NULL, NULL);
+    if (s == INVALID_SOCKET) return NET_INVALID_SOCKET;
+#else
+    int s = accept((int)listener, NULL, NULL);
+    if (s < 0) return NET_INVALID_SOCKET;
+#endif
+    NetSocket sock = (NetSocket)s;
+
+    if (!SetNonBlocking(sock)) {
+        NetCloseSocket(sock);
+        return NET_INVALID_SOCKET;
+    }
+    SetNoDelay(sock);
+    return sock;
+}
+
+NetSocket NetConnectTcp(NetAddress to)
+{
+#if defined(_WIN32)
+    SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == INVALID_SOCKET) return NET_INVALID_SOCKET;
+#else
+    int s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s < 0) return NET_INVALID_SOCKET;
+#endif
+    NetSocket sock = (NetSocket)s;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = to.host;
+    addr.sin_port = to.port;
+
+    if (connect(s, (struct sockaddr *)&addr, sizeof(addr)) != 0 || !SetNonBlocking(sock)) {
+        NetCloseSocket(sock);
+        return NET_INVALID_SOCKET;
+    }
+    SetNoDelay(sock);
+    return sock;
+}
+
+int NetSend(NetSocket sock, const void *data, int size)
+{
+    int sent = (int)send(sock, data, size, NET_SEND_FLAGS);
+    if (sent < 0) return WouldBlock() ? 0 : -1;
+    return sent;
+}
+
+int NetReceive(NetSocket sock, void *data, int size)
+{
+    int received = (int)recv(sock, data, size, 0);
+    if (received == 0) return -1;  // orderly shutdown
+    if (received < 0) return WouldBlock() ? 0 : -1;
+    return received;
+}
+
+void NetCloseSocket(NetSocket sock)
+{
+    if (sock == NET_INVALID_SOCKET) return;
+#if defined(_WIN32)
+    closesocket((SOCKET)sock);
+#else
+    close((int)sock);
+#endif
+}
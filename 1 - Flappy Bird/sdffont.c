@@ -0,0 +1,173 @@
+#include "sdffont.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SDFFONT_GLYPHS 95  // Printable ASCII, what LoadFontEx() loads by default
+
+// Alpha holds the distance with the outline at 0.5; scaling the edge by the
+// screen-space derivative keeps it about one pixel wide at any size
+static const char *sdfFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float distance = texture(texture0, fragTexCoord).a - 0.5;\n"
+    "    float edge = length(vec2(dFdx(distance), dFdy(distance)));\n"
+    "    float alpha = smoothstep(-edge, edge, distance);\n"
+    "    finalColor = vec4(fragColor.rgb*colDiffuse.rgb, fragColor.a*colDiffuse.a*alpha);\n"
+    "}\n";
+
+static Shader shader = { 0 };
+static bool shaderLoaded = false;
+static bool shaderSupported = false;
+
+static void LoadSdfShader(void)
+{
+    if (shaderLoaded) return;
+    shaderLoaded = true;
+
+    // A failed compile hands back raylib's default shader, the same one loading no stages gives
+    Shader fallback = LoadShaderFromMemory(NULL, NULL);
+    shader = LoadShaderFromMemory(NULL, sdfFragmentShader);
+    shaderSupported = shader.id != fallback.id;
+    if (!shaderSupported) TraceLog(LOG_WARNING, "SDFFONT: Shader not supported, fonts load as bitmaps");
+}
+
+void UnloadSdfFonts(void)
+{
+    if (shaderSupported) UnloadShader(shader);
+    shader = (Shader){ 0 };
+    shaderLoaded = false;
+    shaderSupported = false;
+}
+
+static bool LoadCachedFont(const char *cacheName, const char *fileName, Font *font)
+{
+    if (!FileExists(cacheName) || GetFileModTime(cacheName) < GetFileModTime(fileName)) return false;
+
+    int size = 0;
+    unsigned char *data = LoadFileData(cacheName, &size);
+    if (data == NULL) return false;
+
+    SdfFontHeader header;
+    if ((size_t)size < sizeof(header)) goto invalid;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != SDFFONT_MAGIC || header.version != SDFFONT_VERSION || header.baseSize != SDFFONT_SIZE ||
+        header.glyphPadding != SDFFONT_PADDING || header.glyphCount <= 0 || header.glyphCount > 4096 ||
+        header.atlasWidth <= 0 || header.atlasHeight <= 0) goto invalid;
+
+    size_t glyphsSize = (size_t)header.glyphCount * sizeof(SdfFontGlyph);
+    size_t atlasSize = (size_t)GetPixelDataSize(header.atlasWidth, header.atlasHeight, header.atlasFormat);
+    if ((size_t)size != sizeof(header) + glyphsSize + atlasSize) goto invalid;
+
+    *font = (Font){ .baseSize = header.baseSize, .glyphCount = header.glyphCount, .glyphPadding = header.glyphPadding };
+    font->glyphs = MemAlloc(header.glyphCount * sizeof(GlyphInfo));
+    font->recs = MemAlloc(header.glyphCount * sizeof(Rectangle));
+    for (int i = 0; i < header.glyphCount; i++) {
+        SdfFontGlyph glyph;
+        memcpy(&glyph, data + sizeof(header) + i * sizeof(glyph), sizeof(glyph));
+        font->glyphs[i] = (GlyphInfo){ glyph.value, glyph.offsetX, glyph.offsetY, glyph.advanceX, { 0 } };
+        font->recs[i] = glyph.rec;
+    }
+
+    Image atlas = {
+        .data = data + sizeof(header) + glyphsSize,
+        .width = header.atlasWidth,
+        .height = header.atlasHeight,
+        .mipmaps = 1,
+        .format = header.atlasFormat,
+    };
+    font->texture = LoadTextureFromImage(atlas);
+    UnloadFileData(data);
+    return true;
+
+invalid:
+    TraceLog(LOG_INFO, "SDFFONT: [%s] Outdated cache, rebuilding", cacheName);
+    UnloadFileData(data);
+    return false;
+}
+
+static void SaveCachedFont(const char *cacheName, const Font *font, Image atlas)
+{
+    SdfFontHeader header = {
+        SDFFONT_MAGIC, SDFFONT_VERSION, font->baseSize, font->glyphCount, font->glyphPadding,
+        atlas.width, atlas.height, atlas.format,
+    };
+    size_t glyphsSize = (size_t)font->glyphCount * sizeof(SdfFontGlyph);
+    size_t atlasSize = (size_t)GetPixelDataSize(atlas.width, atlas.height, atlas.format);
+    size_t size = sizeof(header) + glyphsSize + atlasSize;
+
+    unsigned char *data = malloc(size);
+    if (data == NULL) return;
+
+    memcpy(data, &header, sizeof(header));
+    for (int i = 0; i < font->glyphCount; i++) {
+        const GlyphInfo *info = &font->glyphs[i];
+        SdfFontGlyph glyph = { info->value, info->offsetX, info->offsetY, info->advanceX, font->recs[i] };
+        memcpy(data + sizeof(header) + i * sizeof(glyph), &glyph, sizeof(glyph));
+    }
+    memcpy(data + sizeof(header) + glyphsSize, atlas.data, atlasSize);
+
+    // Only a cache: a read-only install just builds the field every run
+    if (!SaveFileData(cacheName, data, (int)size)) TraceLog(LOG_WARNING, "SDFFONT: [%s] Failed to write cache", cacheName);
+    free(data);
+}
+
+static bool BuildFont(const char *fileName, const char *cacheName, Font *font)
+{
+    int size = 0;
+    unsigned char *data = LoadFileData(fileName, &size);
+    if (data == NULL) return false;
+
+    *font = (Font){ .baseSize = SDFFONT_SIZE, .glyphCount = SDFFONT_GLYPHS, .glyphPadding = SDFFONT_PADDING };
+    font->glyphs = LoadFontData(data, size, SDFFONT_SIZE, NULL, SDFFONT_GLYPHS, FONT_SDF);
+    UnloadFileData(data);
+    if (font->glyphs == NULL) return false;
+
+    Image atlas = GenImageFontAtlas(font->glyphs, &font->recs, font->glyphCount, SDFFONT_SIZE, SDFFONT_PADDING, 0);
+    font->texture = LoadTextureFromImage(atlas);
+
+    SaveCachedFont(cacheName, font, atlas);
+    UnloadImage(atlas);
+
+    // The glyph images were only needed to pack the atlas
+    for (int i = 0; i < font->glyphCount; i++) {
+        UnloadImage(font->glyphs[i].image);
+        font->glyphs[i].image = (Image){ 0 };
+    }
+    return true;
+}
+
+Font LoadSdfFont(const char *fileName)
+{
+    LoadSdfShader();
+    if (!shaderSupported) return LoadFontEx(fileName, SDFFONT_SIZE, NULL, 0);
+
+    char cacheName[256];
+    snprintf(cacheName, sizeof(cacheName), "%s.sdf", fileName);
+
+    Font font;
+    if (!LoadCachedFont(cacheName, fileName, &font) && !BuildFont(fileName, cacheName, &font)) {
+        TraceLog(LOG_WARNING, "SDFFONT: [%s] Failed to load, using the default font", fileName);
+        return GetFontDefault();
+    }
+
+    // The field has to be sampled between texels
+    SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    return font;
+}
+
+void DrawSdfText(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    // The default font, used when loading failed, is a bitmap and draws as it is
+    bool sdf = shaderSupported && font.texture.id != GetFontDefault().texture.id;
+    if (sdf) BeginShaderMode(shader);
+    DrawTextEx(font, text, position, fontSize, spacing, tint);
+    if (sdf) EndShaderMode();
+}
@@ -0,0 +1,44 @@
+#ifndef SDFFONT_H
+#define SDFFONT_H
+
+#include <stdint.h>
+#include "raylib.h"
+
+/* SDF FONTS */
+// One signed distance field atlas per typeface, drawn at any size through a
+// small shader instead of rasterizing the TTF again for every size the game
+// uses. Building the field is the slow part, so the atlas and glyph metrics
+// are cached next to the font on the first run and read back afterwards.
+// The cache is rebuilt when it is older than the font or was built with
+// other settings. Without shader support fonts load as plain bitmaps.
+// Layout: SdfFontHeader, glyphCount SdfFontGlyph, then the atlas pixels.
+
+#define SDFFONT_MAGIC 0x46464453u  // "SDFF"
+#define SDFFONT_VERSION 1
+#define SDFFONT_SIZE 32            // Glyph height the field is built at
+#define SDFFONT_PADDING 4          // Room around each glyph for the falloff
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int32_t baseSize;
+    int32_t glyphCount;
+    int32_t glyphPadding;
+    int32_t atlasWidth;
+    int32_t atlasHeight;
+    int32_t atlasFormat;  // raylib PixelFormat
+} SdfFontHeader;
+
+typedef struct {
+    int32_t value;
+    int32_t offsetX;
+    int32_t offsetY;
+    int32_t advanceX;
+    Rectangle rec;  // In the atlas
+} SdfFontGlyph;
+
+Font LoadSdfFont(const char *fileName);  // From the cache when it is current, otherwise built and cached
+void UnloadSdfFonts(void);               // The shared shader, after every font is unloaded
+void DrawSdfText(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+
+#endif // SDFFONT_H
@@ -0,0 +1,133 @@
+#include "simthread.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define SLOT_MASK 0x3u
+#define SLOT_FRESH 0x4u  // Set on the middle index when it holds a frame the reader has not taken
+
+static pthread_t simThread;
+static atomic_bool running = false;
+static atomic_bool quit = false;
+static atomic_uint pendingInput = 0;
+
+// The writer owns back, the reader owns front, middle is swapped between them
+static SimFrame slots[3];
+static atomic_uint middle = 1;
+static unsigned int back = 0;
+static unsigned int front = 2;
+
+// head is written only by the main thread, tail only by the simulation thread
+static SimEvent events[SIM_EVENT_QUEUE];
+static atomic_uint head = 0;
+static atomic_uint tail = 0;
+
+static GameSnapshot lastState;  // Simulation thread only, the tick before the one being published
+
+static void PublishFrame(double time, unsigned int tick)
+{
+    SimFrame *frame = &slots[back];
+    frame->previous = lastState;
+    SaveState(&frame->latest);
+    frame->time = time;
+    frame->tick = tick;
+    lastState = frame->latest;
+
+    back = atomic_exchange_explicit(&middle, back | SLOT_FRESH, memory_order_acq_rel) & SLOT_MASK;
+}
+
+static void *SimThreadMain(void *arg)
+{
+    (void)arg;
+
+    double step = 1.0 / SIM_TICK_RATE;
+    double due = GetTime();
+    unsigned int tick = 0;
+
+    while (!atomic_load_explicit(&quit, memory_order_acquire)) {
+        double now = GetTime();
+        if (now < due) {
+            WaitTime(due - now);
+            continue;
+        }
+
+        // After a long stall the missed time is dropped instead of run in one burst
+        if (now - due > SIM_MAX_CATCHUP * step) due = now - SIM_MAX_CATCHUP * step;
+
+        BirdInput input = (BirdInput)atomic_exchange_explicit(&pendingInput, 0, memory_order_acquire);
+        SimulateTick(input, (float)step);
+        PublishFrame(due, ++tick);
+        due += step;
+    }
+    return NULL;
+}
+
+bool StartSimThread(void)
+{
+    if (atomic_load(&running)) return true;
+
+    // The first frame is published from here, so a reader never finds the buffer empty
+    back = 0;
+    front = 2;
+    atomic_store(&middle, 1);
+    SaveState(&lastState);
+    PublishFrame(GetTime(), 0);
+
+    atomic_store(&pendingInput, 0);
+    atomic_store(&quit, false);
+    atomic_store(&running, true);
+    if (pthread_create(&simThread, NULL, SimThreadMain, NULL) != 0) {
+        TraceLog(LOG_WARNING, "SIMTHREAD: Failed to start simulation thread");
+        atomic_store(&running, false);
+        return false;
+    }
+    return true;
+}
+
+void StopSimThread(void)
+{
+    if (!atomic_load(&running)) return;
+
+    atomic_store_explicit(&quit, true, memory_order_release);
+    pthread_join(simThread, NULL);
+    atomic_store(&running, false);
+}
+
+bool IsSimThreadRunning(void)
+{
+    return atomic_load_explicit(&running, memory_order_acquire);
+}
+
+void SendSimInput(BirdInput input)
+{
+    if (input) atomic_fetch_or_explicit(&pendingInput, input, memory_order_release);
+}
+
+const SimFrame *AcquireSimFrame(void)
+{
+    if (atomic_load_explicit(&middle, memory_order_relaxed) & SLOT_FRESH)
+        front = atomic_exchange_explicit(&middle, front, memory_order_acq_rel) & SLOT_MASK;
+    return &slots[front];
+}
+
+bool PostSimEvent(SimEvent event)
+{
+    unsigned int t = atomic_load_explicit(&tail, memory_order_relaxed);
+    if (t - atomic_load_explicit(&head, memory_order_acquire) >= SIM_EVENT_QUEUE) {
+        TraceLog(LOG_WARNING, "SIMTHREAD: Event queue full, event dropped");
+        return false;
+    }
+
+    events[t & (SIM_EVENT_QUEUE - 1)] = event;
+    atomic_store_explicit(&tail, t + 1, memory_order_release);
+    return true;
+}
+
+bool PollSimEvent(SimEvent *event)
+{
+    unsigned int h = atomic_load_explicit(&head, memory_order_relaxed);
+    if (h == atomic_load_explicit(&tail, memory_order_acquire)) return false;
+
+    *event = events[h & (SIM_EVENT_QUEUE - 1)];
+    atomic_store_explicit(&head, h + 1, memory_order_release);
+    return true;
+}
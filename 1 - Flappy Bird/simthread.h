@@ -0,0 +1,52 @@
+#ifndef SIMTHREAD_H
+#define SIMTHREAD_H
+
+#include "game.h"
+
+/* SIMULATION THREAD */
+// With --threaded the game state belongs to a thread that ticks at a fixed
+// SIM_TICK_RATE however long frames take to draw. After every tick it
+// publishes a SimFrame through a triple buffer: three slots and one atomic
+// index, so the sim always has a slot to write and the renderer always has
+// a complete one to read, and neither ever waits for the other. A frame
+// carries the last two ticks, so the renderer can blend them to the present.
+//
+// The main thread never touches the game state while the thread runs: key
+// presses are latched into an atomic word the next tick takes, and whatever
+// the simulation does to the rest of the game (sounds, high scores) comes
+// back as SimEvents through a single-producer, single-consumer ring.
+// Stopping the thread joins it and hands the game state back to the caller.
+
+#define SIM_TICK_RATE 60
+#define SIM_MAX_CATCHUP 5      // Ticks run back to back after a stall, the rest is dropped
+#define SIM_EVENT_QUEUE 64     // Power of two
+
+typedef enum {
+    SIM_EVENT_SOUND,
+    SIM_EVENT_SCORE,       // A run ended with this score
+    SIM_EVENT_RUN_START,   // Per-run memory can be released
+} SimEventType;
+
+typedef struct {
+    SimEventType type;
+    Sound sound;
+    int score;
+} SimEvent;
+
+typedef struct {
+    GameSnapshot previous;
+    GameSnapshot latest;
+    double time;           // GetTime() the latest tick was due at
+    unsigned int tick;
+} SimFrame;
+
+bool StartSimThread(void);             // Takes over the game state
+void StopSimThread(void);              // Joins the thread, the game state is the caller's again
+bool IsSimThreadRunning(void);         // True from StartSimThread() until StopSimThread() returns
+
+void SendSimInput(BirdInput input);    // Main thread: presses since the last call, kept until a tick takes them
+const SimFrame *AcquireSimFrame(void); // Main thread: newest published frame, valid until the next call
+bool PostSimEvent(SimEvent event);     // Simulation thread; false if the ring is full
+bool PollSimEvent(SimEvent *event);    // Main thread
+
+#endif // SIMTHREAD_H
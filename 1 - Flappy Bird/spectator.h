@@ -0,0 +1,43 @@
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+
+#include "stdbool.h"
+
+/* SPECTATOR */
+// A playing session publishes its snapshot every tick over TCP; spectators apply
+// the stream and only render. Each tick is delta-encoded once against the
+// previous tick and the same bytes are queued for every client. New clients
+// get one full keyframe first. A client whose queue overflows is dropped.
+
+#define SPECTATOR_MAX_CLIENTS 32
+
+typedef enum {
+    SPECTATOR_OFF,
+    SPECTATOR_SERVER,
+    SPECTATOR_CLIENT,
+} SpectatorMode;
+
+typedef struct {
+    SpectatorMode mode;
+    int port;
+    char host[64];
+} SpectatorConfig;
+
+typedef struct {
+    int clients;
+    int dropped;         // Slow or closed clients removed so far
+    int lastMessage;     // Bytes of the last encoded tick
+    bool connected;      // Client only
+} SpectatorStats;
+
+// --serve <port> | --spectate <host> <port>
+bool ParseSpectatorArgs(int argc, char *argv[], SpectatorConfig *config);
+bool InitSpectator(const SpectatorConfig *config, int snapshotSize);
+void CloseSpectator(void);
+SpectatorMode GetSpectatorMode(void);
+const SpectatorStats *GetSpectatorStats(void);
+
+void BroadcastSnapshot(const void *snapshot);  // Server: once per tick
+bool ReceiveSnapshot(void *snapshot);          // Client: true when the snapshot changed
+
+#endif // SPECTATOR_H
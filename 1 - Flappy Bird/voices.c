@@ -0,0 +1,149 @@
+#include "voices.h"
+#include "raymath.h"
+#include <stddef.h>
+
+typedef struct {
+    Sound voices[VOICES_MAX_PER_SOUND];       // [0] is the source sound, the rest are aliases
+    unsigned int startedAt[VOICES_MAX_PER_SOUND];
+    bool playing[VOICES_MAX_PER_SOUND];
+    int voiceCount;
+    VoicePriority priority;
+} VoiceBank;
+
+static VoiceBank banks[VOICES_MAX_SOUNDS];
+static int bankCount = 0;
+static int activeVoices = 0;
+static unsigned int playCounter = 0;
+
+bool AddVoices(Sound sound, int voices, VoicePriority priority)
+{
+    if (bankCount >= VOICES_MAX_SOUNDS || !IsSoundValid(sound)) return false;
+    if (voices < 1) voices = 1;
+    if (voices > VOICES_MAX_PER_SOUND) voices = VOICES_MAX_PER_SOUND;
+
+    VoiceBank *bank = &banks[bankCount++];
+    bank->voices[0] = sound;
+    bank->startedAt[0] = 0;
+    bank->playing[0] = false;
+    bank->voiceCount = 1;
+    bank->priority = priority;
+
+    // Aliases share the sample data, each only adds a mixer buffer
+    for (int i = 1; i < voices; i++) {
+        Sound alias = LoadSoundAlias(sound);
+        if (!IsSoundValid(alias)) break;
+        bank->voices[i] = alias;
+        bank->startedAt[i] = 0;
+        bank->playing[i] = false;
+        bank->voiceCount++;
+    }
+    return true;
+}
+
+void UnloadVoices(void)
+{
+    for (int b = 0; b < bankCount; b++) {
+        for (int i = 1; i < banks[b].voiceCount; i++) UnloadSoundAlias(banks[b].voices[i]);
+    }
+    bankCount = 0;
+    activeVoices = 0;
+}
+
+void UpdateVoices(void)
+{
+    for (int b = 0; b < bankCount; b++) {
+        VoiceBank *bank = &banks[b];
+        for (int i = 0; i < bank->voiceCount; i++) {
+            if (bank->playing[i] && !IsSoundPlaying(bank->voices[i])) {
+                bank->playing[i] = false;
+                activeVoices--;
+            }
+        }
+    }
+}
+
+static VoiceBank *FindBank(Sound sound)
+{
+    for (int b = 0; b < bankCount; b++) {
+        if (banks[b].voices[0].stream.buffer == sound.stream.buffer) return &banks[b];
+    }
+    return NULL;
+}
+
+static void StopVoice(VoiceBank *bank, int voice)
+{
+    StopSound(bank->voices[voice]);
+    bank->playing[voice] = false;
+    activeVoices--;
+}
+
+// Oldest voice among the lowest priority ones that are playing
+static bool StealVoice(VoicePriority priority)
+{
+    VoiceBank *victimBank = NULL;
+    int victim = -1;
+
+    for (int b = 0; b < bankCount; b++) {
+        VoiceBank *bank = &banks[b];
+        if (bank->priority > priority) continue;
+        if (victimBank != NULL && bank->priority > victimBank->priority) continue;
+
+        for (int i = 0; i < bank->voiceCount; i++) {
+            if (!bank->playing[i]) continue;
+            if (victimBank == NULL || bank->priority < victimBank->priority ||
+                bank->startedAt[i] < victimBank->startedAt[victim]) {
+                victimBank = bank;
+                victim = i;
+            }
+        }
+    }
+
+    if (victimBank == NULL) return false;
+    StopVoice(victimBank, victim);
+    return true;
+}
+
+void PlayVoice(Sound sound)
+{
+    PlayVoicePanned(sound, 0.0f);
+}
+
+void PlayVoicePanned(Sound sound, float balance)
+{
+    // raylib pans from 1.0 (left) to 0.0 (right)
+    float pan = 0.5f - 0.5f * Clamp(balance, -1.0f, 1.0f);
+
+    VoiceBank *bank = FindBank(sound);
+    if (bank == NULL) {
+        SetSoundPan(sound, pan);
+        PlaySound(sound);
+        return;
+    }
+
+    int voice = -1;
+    for (int i = 0; i < bank->voiceCount && voice < 0; i++) {
+        if (!bank->playing[i]) voice = i;
+    }
+
+    if (voice < 0) {
+        // All of this sound's voices are busy, restart its oldest one
+        voice = 0;
+        for (int i = 1; i < bank->voiceCount; i++) {
+            if (bank->startedAt[i] < bank->startedAt[voice]) voice = i;
+        }
+        StopVoice(bank, voice);
+    } else if (activeVoices >= VOICES_MAX_ACTIVE && !StealVoice(bank->priority)) {
+        return;  // Over budget and nothing less important to give up
+    }
+
+    SetSoundPan(bank->voices[voice], pan);
+    PlaySound(bank->voices[voice]);
+    bank->playing[voice] = true;
+    bank->startedAt[voice] = ++playCounter;
+    activeVoices++;
+}
+
+int GetActiveVoices(void)
+{
+    return activeVoices;
+}
@@ -0,0 +1,72 @@
+#include "arena.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool InitArena(Arena *arena, size_t capacity)
+{
+    memset(arena, 0, sizeof(*arena));
+    arena->base = malloc(capacity);
+    if (arena->base == NULL) return false;
+
+    arena->capacity = capacity;
+    arena->owned = true;
+    return true;
+}
+
+bool InitSubArena(Arena *arena, Arena *parent, size_t capacity)
+{
+    memset(arena, 0, sizeof(*arena));
+    arena->base = ArenaAlloc(parent, capacity);
+    if (arena->base == NULL) return false;
+
+    arena->capacity = capacity;
+    return true;
+}
+
+void UnloadArena(Arena *arena)
+{
+    if (arena->owned) free(arena->base);
+    memset(arena, 0, sizeof(*arena));
+}
+
+void ResetArena(Arena *arena)
+{
+    arena->used = 0;
+    arena->allocations = 0;
+}
+
+void *ArenaAlloc(Arena *arena, size_t size)
+{
+    size_t start = (arena->used + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    if (arena->base == NULL || start > arena->capacity || size > arena->capacity - start) {
+        arena->failures++;
+        return NULL;
+    }
+
+    arena->used = start + size;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    arena->allocations++;
+
+    void *memory = arena->base + start;
+    memset(memory, 0, size);
+    return memory;
+}
+
+const char *ArenaFormat(Arena *arena, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    if (length < 0) return "";
+
+    char *text = ArenaAlloc(arena, (size_t)length + 1);
+    if (text == NULL) return "";
+
+    va_start(args, format);
+    vsnprintf(text, (size_t)length + 1, format, args);
+    va_end(args);
+    return text;
+}
@@ -0,0 +1,33 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include "stdbool.h"
+
+/* ARENA */
+// Bump allocator over one block reserved at startup. Allocation is a pointer
+// bump and freeing is resetting the whole arena, so transient data costs no
+// heap calls during play. Sub-arenas are carved out of a parent's block.
+// Not thread safe; each arena belongs to the thread that resets it.
+
+#define ARENA_ALIGNMENT 16
+
+typedef struct {
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+    size_t peak;      // High-water mark since init
+    int allocations;  // Since the last reset
+    int failures;     // Requests that did not fit, since init
+    bool owned;       // base came from malloc, not from a parent arena
+} Arena;
+
+bool InitArena(Arena *arena, size_t capacity);               // The only heap call
+bool InitSubArena(Arena *arena, Arena *parent, size_t capacity);
+void UnloadArena(Arena *arena);
+void ResetArena(Arena *arena);
+
+void *ArenaAlloc(Arena *arena, size_t size);                 // Zeroed, NULL when full
+const char *ArenaFormat(Arena *arena, const char *format, ...);  // "" when full
+
+#endif // ARENA_H
@@ -0,0 +1,81 @@
+#include "audioevents.h"
+#include "voices.h"
+#include <stddef.h>
+
+// One entry per sound emitted this frame, so a busy frame fills the queue with
+// distinct sounds rather than repeats of the same hit
+typedef struct {
+    Sound sound;
+    float balanceSum;
+    int count;
+} AudioEvent;
+
+typedef struct {
+    void *buffer;  // Identifies the sound
+    double lastStarted;
+} AudioEventGroup;
+
+static AudioEvent events[AUDIO_EVENT_QUEUE];
+static int eventCount = 0;
+static AudioEventGroup groups[AUDIO_EVENT_SOUNDS];
+static int groupCount = 0;
+static int mergedEvents = 0;
+
+void PushAudioEvent(Sound sound, float balance)
+{
+    for (int i = 0; i < eventCount; i++) {
+        if (events[i].sound.stream.buffer == sound.stream.buffer) {
+            events[i].balanceSum += balance;
+            events[i].count++;
+            return;
+        }
+    }
+
+    // More distinct sounds than the queue holds in one frame: play it now rather than lose it
+    if (eventCount >= AUDIO_EVENT_QUEUE) {
+        PlayVoicePanned(sound, balance);
+        return;
+    }
+    events[eventCount++] = (AudioEvent){ sound, balance, 1 };
+}
+
+static AudioEventGroup *FindGroup(Sound sound)
+{
+    for (int i = 0; i < groupCount; i++) {
+        if (groups[i].buffer == sound.stream.buffer) return &groups[i];
+    }
+    if (groupCount >= AUDIO_EVENT_SOUNDS) return NULL;
+
+    AudioEventGroup *group = &groups[groupCount++];
+    group->buffer = sound.stream.buffer;
+    group->lastStarted = -AUDIO_MERGE_WINDOW;
+    return group;
+}
+
+// Each sound starts at most once per flush, in the order it was first emitted
+void FlushAudioEvents(double time)
+{
+    for (int i = 0; i < eventCount; i++) {
+        const AudioEvent *event = &events[i];
+        float balance = event->balanceSum / event->count;
+
+        AudioEventGroup *group = FindGroup(event->sound);
+        if (group == NULL) {
+            PlayVoicePanned(event->sound, balance);
+            mergedEvents += event->count - 1;
+        } else if (time - group->lastStarted >= AUDIO_MERGE_WINDOW) {
+            PlayVoicePanned(event->sound, balance);
+            group->lastStarted = time;
+            mergedEvents += event->count - 1;
+        } else {
+            mergedEvents += event->count;
+        }
+    }
+
+    eventCount = 0;
+}
+
+int GetMergedAudioEvents(void)
+{
+    return mergedEvents;
+}
@@ -0,0 +1,20 @@
+#ifndef AUDIOEVENTS_H
+#define AUDIOEVENTS_H
+
+#include "raylib.h"
+
+/* AUDIO EVENTS */
+// The simulation only records what made a sound and where; the mixer runs once
+// per frame. Events of the same sound in one frame collapse into a single voice
+// panned to their average position, and a repeat within AUDIO_MERGE_WINDOW of
+// the last time that sound started is folded into the voice already playing.
+
+#define AUDIO_EVENT_QUEUE 64      // Distinct sounds per frame, merged as they are pushed
+#define AUDIO_EVENT_SOUNDS 32
+#define AUDIO_MERGE_WINDOW 0.025  // Seconds
+
+void PushAudioEvent(Sound sound, float balance);  // balance: -1 left, 0 center, 1 right
+void FlushAudioEvents(double time);               // Once per frame, plays what is left after merging
+int GetMergedAudioEvents(void);                   // Events folded into another voice so far
+
+#endif // AUDIOEVENTS_H
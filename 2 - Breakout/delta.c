@@ -0,0 +1,74 @@
+#include "delta.h"
+#include <string.h>
+
+#define DELTA_MAX_RUN 0xFFFF
+// A run header costs 4 bytes, so shorter equal stretches are cheaper kept as literals
+#define DELTA_MIN_SKIP 4
+
+static void PutU16(unsigned char *p, int v)
+{
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static int GetU16(const unsigned char *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+int DeltaEncode(const void *base, const void *current, int size, unsigned char *out, int capacity)
+{
+    const unsigned char *a = base;
+    const unsigned char *b = current;
+    int written = 0;
+    int i = 0;
+
+    while (i < size) {
+        int skip = 0;
+        while (i + skip < size && skip < DELTA_MAX_RUN && a[i + skip] == b[i + skip]) skip++;
+        if (i + skip == size) break;  // trailing equal bytes need no run
+
+        int start = i + skip;
+        int literal = 0;
+        int equal = 0;
+        while (start + literal < size && literal < DELTA_MAX_RUN) {
+            if (a[start + literal] == b[start + literal]) {
+                if (++equal >= DELTA_MIN_SKIP) break;
+            } else {
+                equal = 0;
+            }
+            literal++;
+        }
+        literal -= (equal < DELTA_MIN_SKIP) ? 0 : equal - 1;
+
+        if (written + 4 + literal > capacity) return -1;
+        PutU16(out + written, skip);
+        PutU16(out + written + 2, literal);
+        memcpy(out + written + 4, b + start, literal);
+        written += 4 + literal;
+        i = start + literal;
+    }
+
+    return written;
+}
+
+bool DeltaDecode(const void *base, const unsigned char *delta, int deltaSize, void *out, int size)
+{
+    unsigned char *dst = out;
+    int pos = 0;
+    int read = 0;
+
+    memcpy(dst, base, size);
+    while (read + 4 <= deltaSize) {
+        int skip = GetU16(delta + read);
+        int literal = GetU16(delta + read + 2);
+        read += 4;
+        pos += skip;
+        if (pos + literal > size || read + literal > deltaSize) return false;
+        memcpy(dst + pos, delta + read, literal);
+        pos += literal;
+        read += literal;
+    }
+
+    return read == deltaSize;
+}
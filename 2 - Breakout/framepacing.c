@@ -0,0 +1,147 @@
+#include "framepacing.h"
+#include <math.h>
+
+static bool frameIdle = false;
+static bool wokeFromIdle = false;  // This frame's input poll blocked on events
+
+void SetFrameIdle(bool idle)
+{
+    if (idle == frameIdle) return;
+
+    frameIdle = idle;
+    if (idle) EnableEventWaiting();
+    else DisableEventWaiting();
+}
+
+#if !defined(FRAME_PACING)
+
+static float nominalFrameTime = 1.0f / 60;
+
+void InitFramePacing(int targetFps)
+{
+    nominalFrameTime = 1.0f / targetFps;
+    SetTargetFPS(targetFps);
+}
+
+// EndDrawing() already polled for this frame, waiting if the last one was idle
+void BeginPacedFrame(void)
+{
+    wokeFromIdle = frameIdle;
+}
+
+void EndPacedFrame(void) { }
+
+float GetPacedFrameTime(void)
+{
+    return wokeFromIdle ? nominalFrameTime : GetFrameTime();
+}
+
+#else
+
+#define MIN_SLEEP_MARGIN 0.0005
+
+typedef struct {
+    double period;
+    double due;          // When the next frame should be on screen
+    double pollTime;     // When this frame's input was polled
+    double frameTime;
+    double workPeak;     // Slowest recent poll-to-swap, decaying
+    double sleepMargin;  // Left to spin after sleeping, follows how late wake-ups are
+
+    // Since the last report
+    double reportStart;
+    double latencySum;
+    double latencyMax;
+    double spinSum;
+    int frames;
+    int late;            // Frames that could not wait at all
+} FramePacing;
+
+static FramePacing pacing = { 0 };
+
+void InitFramePacing(int targetFps)
+{
+    double now = GetTime();
+    pacing = (FramePacing){ 0 };
+    pacing.period = 1.0 / targetFps;
+    pacing.due = now + pacing.period;
+    pacing.pollTime = now;
+    pacing.frameTime = pacing.period;
+    pacing.sleepMargin = pacing.period / 4;  // Conservative until the first wake-ups are measured
+    pacing.reportStart = now;
+}
+
+// Sleeps until a margin before the deadline, then spins the rest
+static void WaitUntil(double deadline)
+{
+    double remaining = deadline - GetTime();
+    if (remaining > pacing.sleepMargin) {
+        double requested = remaining - pacing.sleepMargin;
+        double start = GetTime();
+        WaitTime(requested);
+        double oversleep = GetTime() - start - requested;
+
+        // Jump to a late wake-up at once, come back down slowly while the timer behaves
+        double margin = fmax(pacing.sleepMargin * 0.99, oversleep * 1.25);
+        pacing.sleepMargin = fmin(fmax(margin, MIN_SLEEP_MARGIN), pacing.period);
+    }
+
+    double spinStart = GetTime();
+    while (GetTime() < deadline) { }
+    pacing.spinSum += GetTime() - spinStart;
+}
+
+void BeginPacedFrame(void)
+{
+    wokeFromIdle = frameIdle;
+
+    // Poll as late as the slowest recent frame allows, unless the poll itself is going to block
+    if (!wokeFromIdle) {
+        double deadline = pacing.due - pacing.workPeak - FRAME_PACING_WORK_SAFETY;
+        if (GetTime() < deadline) WaitUntil(deadline);
+        else pacing.late++;
+    }
+
+    PollInputEvents();
+    double now = GetTime();
+    pacing.frameTime = wokeFromIdle ? pacing.period : now - pacing.pollTime;
+    pacing.pollTime = now;
+    if (wokeFromIdle) pacing.due = now + pacing.period;
+}
+
+void EndPacedFrame(void)
+{
+    double work = GetTime() - pacing.pollTime;
+    pacing.workPeak = fmax(work, pacing.workPeak * 0.98);
+
+    SwapScreenBuffer();
+    double present = GetTime();
+
+    // With vsync the swap returns at the vblank and the schedule follows it; without,
+    // frames stay on a fixed grid unless one runs late
+    pacing.due = fmax(present, pacing.due) + pacing.period;
+
+    double latency = present - pacing.pollTime;
+    pacing.latencySum += latency;
+    pacing.latencyMax = fmax(pacing.latencyMax, latency);
+    pacing.frames++;
+
+    if (present - pacing.reportStart >= FRAME_PACING_LOG_INTERVAL) {
+        TraceLog(LOG_INFO, "PACING: Input to present %.2f ms avg, %.2f ms max; spinning %.2f ms a frame, sleep margin %.2f ms, %d late",
+                 pacing.latencySum / pacing.frames * 1000.0, pacing.latencyMax * 1000.0,
+                 pacing.spinSum / pacing.frames * 1000.0, pacing.sleepMargin * 1000.0, pacing.late);
+        pacing.reportStart = present;
+        pacing.latencySum = 0.0;
+        pacing.latencyMax = 0.0;
+        pacing.spinSum = 0.0;
+        pacing.frames = 0;
+        pacing.late = 0;
+    }
+}
+
+float GetPacedFrameTime(void)
+{
+    return (float)pacing.frameTime;
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef FRAMEPACING_H
+#define FRAMEPACING_H
+
+#include "raylib.h"
+
+/* FRAME PACING */
+// Built with FRAME_PACING (make FRAME_PACING=1) the game drives its own
+// frame loop through raylib's custom frame control: each frame waits first
+// and polls input as late as it can, leaving just enough time for the
+// slowest recent update + draw before the frame is due. The wait sleeps for
+// most of the time and spins the rest, with the spin margin following how
+// late the OS has actually been waking up. The time from polling input to
+// presenting the frame is logged every few seconds.
+//
+// This needs a raylib built with SUPPORT_CUSTOM_FRAME_CONTROL, otherwise
+// EndDrawing() still swaps and polls itself; the bundled library is not.
+// Without FRAME_PACING these fall back to SetTargetFPS() and GetFrameTime().
+//
+// While a frame is marked idle, nothing on screen moves by itself: instead
+// of drawing at the target rate the loop blocks until an input or window
+// event arrives, then draws the one frame it may have changed. The frame
+// after a wait reports the nominal frame time rather than the time blocked.
+
+#define FRAME_PACING_LOG_INTERVAL 5.0   // Seconds between latency reports
+#define FRAME_PACING_WORK_SAFETY 0.001  // Added to the slowest recent frame's work
+
+void InitFramePacing(int targetFps);
+void BeginPacedFrame(void);      // Waits, then polls input; call before UpdateDrawFrame()
+void EndPacedFrame(void);        // Presents; call after UpdateDrawFrame()
+float GetPacedFrameTime(void);   // Seconds between the last two input polls
+void SetFrameIdle(bool idle);    // Before drawing; the next poll blocks until an event when idle
+
+#endif // FRAMEPACING_H
@@ -1,4 +1,5 @@
 #include "game.h"
+#include "levelgen.h"
 #include "raylib.h"
 #include <math.h>
 #include <stdio.h>
@@ -10,36 +11,73 @@ int gameScreenWidth = 432;
 int gameScreenHeight = 243;
 
 bool isPaused = false;
+bool showDebugOverlay = false;
+bool nativeResolution = false;
+int turboTicks = 1;
+
+Arena permanentArena;
+Arena levelArena;
+Arena frameArena;
 
 GameState currentState = STATE_START;
 
 StartMenu startMenu = { .highlighted = 1 };
 
 Paddle playerPaddle;
+Paddle opponentPaddle = { .skin = 2, .size = 2 };  // Placed by StartVersusMatch(), a valid sprite even before
 
 Color blueColor = {103, 255, 255, 255};
 
 Rectangle paddleQuads[PADDLE_SKINS * PADDLE_SIZES];
-Rectangle ballQuads[7];
-Ball ball;
+Rectangle ballQuads[BALL_SKINS];
+BallPool balls;
+unsigned char ballHits[MAX_BALLS];  // Scratch mask for the paddle pass
 int brickCount;
 Brick bricks[MAX_BRICKS];
+uint64_t brickLive[BRICK_WORDS];
+int bricksLeft;
 Rectangle brickQuads[BRICK_QUAD_COUNT];
+short brickGrid[BRICK_GRID_ROWS][BRICK_GRID_COLS];  // Brick index or -1, rebuilt from bricks
+float brickGridY;
+Rectangle lockedBrickQuad = { 160, 48, BRICK_WIDTH, BRICK_HEIGHT };
+
+PowerupPool powerups;
+EffectQueue effects;  // Filled and drained within one tick
+bool hasKey = false;
+Rectangle powerupQuads[POWERUP_TYPE_COUNT];
 
 int health;
 int score;
 int level;
 
+// Versus mode, player 2 owns the top paddle
+bool versusMode = false;
+bool isResimulating = false;  // set while netplay replays ticks, keeps rollbacks silent
+int opponentHealth;
+int opponentScore;
+int servingPlayer = 0;
+
+unsigned int rngState = 1;
+unsigned int nextLevelSeed = 1;  // Drawn when a wall is installed, the next one is built from it
+
+GameSnapshot quickSave;
+bool hasQuickSave = false;
+
+RewindBuffer rewindBuffer;
+GameSnapshot rewindFrame;
+bool isRewinding = false;
+int rewindCursor = 0;  // frames back from the newest recorded tick
+
+GameSnapshot spectatorFrame;
+
 // Resources
-Texture2D backgroundTexture;
-Texture2D mainTexture;
-Texture2D arrowsTexture;
-Texture2D heartsTexture;
-Texture2D particleTexture;
+TextureHandle backgroundTexture;
+TextureHandle mainTexture;
+TextureHandle arrowsTexture;
+TextureHandle heartsTexture;
+TextureHandle particleTexture;
 
-Font smallFont;
-Font mediumFont;
-Font largeFont;
+FontHandle gameFont;
 
 Sound paddleHitSound;
 Sound scoreSound;
@@ -54,83 +92,142 @@ Sound victorySound;
 Sound recoverSound;
 Sound highScoreSound;
 Sound pauseSound;
-Music music;
 
-int main() {
+int main(int argc, char *argv[]) {
     SetTraceLogLevel(LOG_DEBUG);
 
+    if (!InitArenas()) {
+        TraceLog(LOG_ERROR, "ARENA: Could not reserve %d KB", PERMANENT_ARENA_SIZE / 1024);
+        return 1;
+    }
+
+    // One worker per spare core for asset decoding and level building
+    InitJobs(-1);
+
+    NetplayConfig netplayConfig;
+    bool netplay = ParseNetplayArgs(argc, argv, &netplayConfig);
+    SpectatorConfig spectatorConfig;
+    bool spectator = ParseSpectatorArgs(argc, argv, &spectatorConfig);
+    const char *levelPackName = "res/levels.lvl";
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--levels") == 0) levelPackName = argv[++i];
+        else if (strcmp(argv[i], "--turbo") == 0) turboTicks = MIN(MAX(atoi(argv[++i]), 1), TURBO_MAX);
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--native") == 0) nativeResolution = true;
+    }
+
     /* Initialization: Set up the window and load game resources. */
     SetConfigFlags(FLAG_VSYNC_HINT | FLAG_WINDOW_RESIZABLE);
     InitWindow(screenWidth, screenHeight, "Breakout");
 
     InitAudioDevice();
 
+    InitHighScores("highscores.dat");
+
     // Load Fonts
-    smallFont = LoadFontEx("res/fonts/font.ttf", 8, 0, 0);
-    mediumFont = LoadFontEx("res/fonts/font.ttf", 16, 0, 0);
-    largeFont = LoadFontEx("res/fonts/font.ttf", 32, 0, 0);
-
-    // Load Graphics
-    backgroundTexture = LoadTexture("res/graphics/background.png");
-    mainTexture = LoadTexture("res/graphics/breakout.png");
-    arrowsTexture = LoadTexture("res/graphics/arrows.png");
-    heartsTexture = LoadTexture("res/graphics/hearts.png");
-    particleTexture = LoadTexture("res/graphics/particle.png");
-
-    // Load Sounds / Music
-    paddleHitSound = LoadSound("res/sounds/paddle_hit.wav");
-    scoreSound = LoadSound("res/sounds/score.wav");
-    wallHitSound = LoadSound("res/sounds/wall_hit.wav");
-    confirmSound = LoadSound("res/sounds/confirm.wav");
-    selectSound = LoadSound("res/sounds/select.wav");
-    noSelectSound = LoadSound("res/sounds/no-select.wav");
-    brickHit1Sound = LoadSound("res/sounds/brick-hit-1.wav");
-    brickHit2Sound = LoadSound("res/sounds/brick-hit-2.wav");
-    hurtSound = LoadSound("res/sounds/hurt.wav");
-    victorySound = LoadSound("res/sounds/victory.wav");
-    recoverSound = LoadSound("res/sounds/recover.wav");
-    highScoreSound = LoadSound("res/sounds/high_score.wav");
-    pauseSound = LoadSound("res/sounds/pause.wav");
-    music = LoadMusicStream("res/sounds/music.wav");
-
-    // Start music
-    SetMusicVolume(music, 0.25f);
-    // PlayMusicStream(music);
+    gameFont = AcquireFont("res/fonts/font.ttf");  // Every size from one SDF atlas
+
+    // Load Graphics, cooked into res/textures.pak by 'make textures' (falls back to the PNGs)
+    LoadTexturePack("res/textures.pak");
+    const char *textureFiles[] = {
+        "res/graphics/background.png", "res/graphics/breakout.png", "res/graphics/arrows.png",
+        "res/graphics/hearts.png", "res/graphics/particle.png",
+    };
+    TextureHandle textures[5];
+    AcquireTextures(textures, textureFiles, 5);  // Decoded on the job threads, uploaded here
+    backgroundTexture = textures[0];
+    mainTexture = textures[1];
+    arrowsTexture = textures[2];
+    heartsTexture = textures[3];
+    particleTexture = textures[4];
+    UnloadTexturePack();
+
+    // Load Sounds, cooked into res/sounds.pak by 'make audio' (falls back to the WAVs)
+    LoadAudioPack("res/sounds.pak");
+    paddleHitSound = LoadPackedSound("res/sounds/paddle_hit.wav");
+    scoreSound = LoadPackedSound("res/sounds/score.wav");
+    wallHitSound = LoadPackedSound("res/sounds/wall_hit.wav");
+    confirmSound = LoadPackedSound("res/sounds/confirm.wav");
+    selectSound = LoadPackedSound("res/sounds/select.wav");
+    noSelectSound = LoadPackedSound("res/sounds/no-select.wav");
+    brickHit1Sound = LoadPackedSound("res/sounds/brick-hit-1.wav");
+    brickHit2Sound = LoadPackedSound("res/sounds/brick-hit-2.wav");
+    hurtSound = LoadPackedSound("res/sounds/hurt.wav");
+    victorySound = LoadPackedSound("res/sounds/victory.wav");
+    recoverSound = LoadPackedSound("res/sounds/recover.wav");
+    highScoreSound = LoadPackedSound("res/sounds/high_score.wav");
+    pauseSound = LoadPackedSound("res/sounds/pause.wav");
+    UnloadAudioPack();
+
+    // Handcrafted levels, compiled into res/levels.lvl by 'make levels'
+    if (OpenLevelPack(levelPackName))
+        TraceLog(LOG_INFO, "LEVELPACK: [%s] %d levels", levelPackName, GetLevelPackCount());
+    else
+        TraceLog(LOG_WARNING, "LEVELPACK: [%s] Missing or outdated, using generated levels only", levelPackName);
+
+    // Voices per sound, enough to overlap a burst of the same event
+    AddVoices(paddleHitSound, 4, VOICE_PRIORITY_NORMAL);
+    AddVoices(scoreSound, 4, VOICE_PRIORITY_NORMAL);
+    AddVoices(wallHitSound, 4, VOICE_PRIORITY_LOW);
+    AddVoices(confirmSound, 2, VOICE_PRIORITY_HIGH);
+    AddVoices(selectSound, 2, VOICE_PRIORITY_HIGH);
+    AddVoices(noSelectSound, 2, VOICE_PRIORITY_HIGH);
+    AddVoices(brickHit1Sound, 6, VOICE_PRIORITY_NORMAL);
+    AddVoices(brickHit2Sound, 6, VOICE_PRIORITY_NORMAL);
+    AddVoices(hurtSound, 2, VOICE_PRIORITY_HIGH);
+    AddVoices(victorySound, 1, VOICE_PRIORITY_HIGH);
+    AddVoices(recoverSound, 2, VOICE_PRIORITY_HIGH);
+    AddVoices(highScoreSound, 1, VOICE_PRIORITY_HIGH);
+    AddVoices(pauseSound, 1, VOICE_PRIORITY_HIGH);
 
     // Render texture initialization, used to hold the rendering result so we can easily resize it
-    RenderTexture2D target = LoadRenderTexture(gameScreenWidth, gameScreenHeight);
-    SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);  // Texture scale filter to use
+    RenderTexture2D target = { 0 };
+    if (!nativeResolution) {
+        target = LoadRenderTexture(gameScreenWidth, gameScreenHeight);
+        SetTextureFilter(target.texture, TEXTURE_FILTER_POINT);  // Texture scale filter to use
+    }
+
+    SeedRandom((unsigned int)time(NULL));
 
     InitGameState();
     InitPaddleQuads();
     InitPaddle(&playerPaddle);
     InitBallQuads();
-    InitBall(&ball);
+    ResetBalls();
     InitBrickQuads();
     InitBricks();
+    InitPowerupQuads();
 
-    srand(time(NULL));
-    SetTargetFPS(60);
+    if (!InitRewind(&rewindBuffer, sizeof(GameSnapshot), REWIND_SECONDS * 60, REWIND_KEYFRAME_INTERVAL))
+        TraceLog(LOG_WARNING, "REWIND: Failed to allocate rewind buffer");
+    else
+        TraceLog(LOG_INFO, "REWIND: %d KB for %d seconds", RewindMemoryUsage(&rewindBuffer) / 1024, REWIND_SECONDS);
 
-    while (!WindowShouldClose()) {
+    // GetTime() counts from InitWindow(), the per-asset times are logged as they load
+    TraceLog(LOG_INFO, "STARTUP: Ready %.1f ms after opening the window", GetTime() * 1000.0);
+
+    if (netplay && !InitNetplay(&netplayConfig))
+        TraceLog(LOG_WARNING, "NETPLAY: Failed to start, falling back to single player");
+
+    if (spectator && !InitSpectator(&spectatorConfig, sizeof(GameSnapshot)))
+        TraceLog(LOG_WARNING, "SPECTATOR: Failed to start");
 
+    InitFramePacing(60);
+
+    while (!WindowShouldClose()) {
+        BeginPacedFrame();
         UpdateDrawFrame(target);
+        EndPacedFrame();
     }
 
     /* De-Initialization: Clean up resources and close the window. */
-    // Load Fonts
-    UnloadFont(smallFont);
-    UnloadFont(mediumFont);
-    UnloadFont(largeFont);
-
-    // Load Graphics
-    UnloadTexture(backgroundTexture);
-    UnloadTexture(mainTexture);
-    UnloadTexture(arrowsTexture);
-    UnloadTexture(heartsTexture);
-    UnloadTexture(particleTexture);
-
-    // Load Sounds / Music
+    // Fonts and Graphics
+    LogResourceReport();
+    UnloadResources();
+
+    // Load Sounds
+    UnloadVoices();
     UnloadSound(paddleHitSound);
     UnloadSound(scoreSound);
     UnloadSound(wallHitSound);
@@ -144,74 +241,234 @@ int main() {
     UnloadSound(recoverSound);
     UnloadSound(highScoreSound);
     UnloadSound(pauseSound);
-    UnloadMusicStream(music);
+
+    CloseJobs();  // Before the level pack, a level may still be building from it
+    CloseLevelPack();
+    CloseSpectator();
+    CloseNetplay();
+    UnloadRewind(&rewindBuffer);
+    CloseHighScores();
 
     CloseWindow(); // Close window and OpenGL context
 
+    UnloadArenas();
+
     return 0;
 }
 
+// Largest whole-number zoom that fits the window, centred on a whole pixel,
+// so every virtual pixel covers the same square of screen pixels
+static Camera2D NativeCamera(void)
+{
+    int zoom = MIN(GetScreenWidth() / gameScreenWidth, GetScreenHeight() / gameScreenHeight);
+    if (zoom < 1) zoom = 1;
+
+    return (Camera2D){
+        .offset = { (float)((GetScreenWidth() - gameScreenWidth*zoom) / 2), (float)((GetScreenHeight() - gameScreenHeight*zoom) / 2) },
+        .zoom = (float)zoom,
+    };
+}
+
+// The whole frame in virtual screen coordinates, for either render path
+static void DrawScene(void)
+{
+    ClearBackground(WHITE);
+
+    // Background
+    Texture2D background = GetTexture(backgroundTexture);
+    Rectangle src = { 0, 0, background.width, background.height };
+    Rectangle dst = { 0, 0, gameScreenWidth + 1, gameScreenHeight + 2 };
+    DrawTexturePro(background, src, dst, (Vector2){0,0}, 0, WHITE);
+
+    if (currentState == STATE_START)
+        DrawStartMenu();
+    else if (currentState == STATE_PLAY)
+        DrawGame();
+    else if (currentState == STATE_SERVE)
+        DrawServe();
+    else if (currentState == STATE_GAME_OVER)
+        DrawGameOver();
+    else if (currentState == STATE_HIGH_SCORES)
+        DrawHighScores();
+    else if (currentState == STATE_VICTORY)
+        DrawVictory();
+
+    if (isRewinding)
+        DrawRewind();
+    if (IsNetplayActive())
+        DrawNetplayStatus();
+    if (GetSpectatorMode() != SPECTATOR_OFF)
+        DrawSpectatorStatus();
+
+    if (showDebugOverlay)
+        DrawDebugOverlay();
+
+    DrawFPSCustom();
+}
+
+// Play runs at turbo speed, the menus wait for the player
+static bool IsTurboState(GameState state)
+{
+    return state == STATE_SERVE || state == STATE_PLAY || state == STATE_VICTORY;
+}
+
+// One tick of whatever the current state does, recorded for rewind
+static void UpdateState(const PaddleInput *inputs, float dt)
+{
+    switch (currentState) {
+        case STATE_START:
+            UpdateStartMenu();
+            break;
+        case STATE_SERVE:
+            ServeState(inputs, dt);
+            break;
+        case STATE_PLAY:
+            GameLogic(inputs, dt);
+            break;
+        case STATE_GAME_OVER:
+            GameOverState();
+            break;
+        case STATE_HIGH_SCORES:
+            UpdateHighScores();
+            break;
+        case STATE_VICTORY:
+            VictoryState(inputs, dt);
+            break;
+    }
+
+    if (currentState == STATE_PLAY || currentState == STATE_SERVE) {
+        SaveState(&rewindFrame);
+        RewindPush(&rewindBuffer, &rewindFrame);
+    }
+}
+
 void UpdateDrawFrame(RenderTexture2D target)
 {
-    if (currentState == STATE_PLAY && IsKeyPressed(KEY_SPACE)) {
+    bool netplay = IsNetplayActive();
+    bool spectating = GetSpectatorMode() == SPECTATOR_CLIENT;
+    bool locked = netplay || spectating;  // Time belongs to someone else
+
+    if (currentState == STATE_PLAY && !locked && !isRewinding && IsKeyPressed(KEY_SPACE)) {
         isPaused = !isPaused;
-        PlaySound(pauseSound);
+        PlayVoice(pauseSound);
+    }
 
-        if (isPaused) PauseMusicStream(music);
-        else ResumeMusicStream(music);
+    // Quick save / quick load
+    if (IsKeyPressed(KEY_F5) && !locked && (currentState == STATE_PLAY || currentState == STATE_SERVE)) {
+        SaveState(&quickSave);
+        hasQuickSave = true;
+        PlayVoice(selectSound);
+    }
+    if (IsKeyPressed(KEY_F9) && !locked && hasQuickSave) {
+        if (LoadState(&quickSave)) PlayVoice(recoverSound);
+        else PlayVoice(noSelectSound);
     }
 
-    float deltaTime = GetFrameTime();
-    // Compute required framebuffer scaling
-    float scale = MIN((float)GetScreenWidth()/gameScreenWidth, (float)GetScreenHeight()/gameScreenHeight);
+    if (IsKeyPressed(KEY_F3)) showDebugOverlay = !showDebugOverlay;
+    if (IsKeyPressed(KEY_F4)) LogResourceReport();
 
-    UpdateMusicStream(music);
+    // Chaos: M splits every ball in play in two
+    if (IsKeyPressed(KEY_M) && !locked && !isPaused && !isRewinding && currentState == STATE_PLAY) {
+        SplitBalls(1);
+    }
 
-    if (!isPaused) {
-        switch (currentState) {
-            case STATE_START:
-                UpdateStartMenu();
-                break;
-            case STATE_SERVE:
-                ServeState(deltaTime);
-                break;
-            case STATE_PLAY:
-                GameLogic(deltaTime);
-                break;
-            case STATE_GAME_OVER:
-                GameOverState();
-                break;
+    // Turbo: T cycles 1x, 8x, TURBO_MAX
+    if (IsKeyPressed(KEY_T) && !locked) {
+        turboTicks = (turboTicks >= TURBO_MAX) ? 1 : (turboTicks >= 8) ? TURBO_MAX : 8;
+        PlayVoice(selectSound);
+    }
+
+    // Rewind: F2 stops time to scrub through recorded ticks, F2 again resumes from there
+    if (IsKeyPressed(KEY_F2) && !locked && !isPaused) {
+        if (isRewinding) {
+            RewindDrop(&rewindBuffer, rewindCursor);
+            isRewinding = false;
+        } else if ((currentState == STATE_PLAY || currentState == STATE_SERVE) && RewindFrameCount(&rewindBuffer) > 0) {
+            isRewinding = true;
+            rewindCursor = 0;
         }
     }
 
-    BeginTextureMode(target);
-        ClearBackground(WHITE);
-        
-        // Background
-        Rectangle src = { 0, 0, backgroundTexture.width, backgroundTexture.height };
-        Rectangle dst = { 0, 0, gameScreenWidth + 1, gameScreenHeight + 2 };
-        DrawTexturePro(backgroundTexture, src, dst, (Vector2){0,0}, 0, WHITE);
+    float deltaTime = GetPacedFrameTime();
+
+    UpdateVoices();
+
+    if (spectating) {
+        if (ReceiveSnapshot(&spectatorFrame)) LoadState(&spectatorFrame);
+    } else if (netplay) {
+        UpdateNetplay(deltaTime);
+    } else if (isRewinding) {
+        UpdateRewind();
+    } else if (!isPaused) {
+        PaddleInput input = ReadPaddleInput();
+
+        // A key press counts once, not once per turbo tick; a menu reached mid-frame waits for the next one
+        for (int tick = 0; tick < turboTicks; tick++) {
+            PaddleInput inputs[2] = { (tick == 0) ? input : (input & ~INPUT_SERVE), 0 };
+            UpdateState(inputs, deltaTime);
+            if (!IsTurboState(currentState)) break;
+        }
+    }
+
+    if (GetSpectatorMode() == SPECTATOR_SERVER) {
+        SaveState(&spectatorFrame);
+        BroadcastSnapshot(&spectatorFrame);
+    }
+
+    FlushAudioEvents(GetTime());
+
+    // Paused or on the start menu nothing moves until a key is pressed, so wait for one
+    // instead of redrawing the same frame; the network modes have to keep polling
+    bool idle = (isPaused || currentState == STATE_START) && !isRewinding && !netplay && GetSpectatorMode() == SPECTATOR_OFF;
+    SetFrameIdle(idle);
+
+    if (nativeResolution) {
+        Camera2D camera = NativeCamera();
+        BeginDrawing();
+            ClearBackground(WHITE);     // Letterbox bars
+
+            BeginScissorMode((int)camera.offset.x, (int)camera.offset.y,
+                             gameScreenWidth*(int)camera.zoom, gameScreenHeight*(int)camera.zoom);
+            BeginMode2D(camera);
+                DrawScene();
+            EndMode2D();
+            EndScissorMode();
+        EndDrawing();
+    } else {
+        // Compute required framebuffer scaling
+        float scale = MIN((float)GetScreenWidth()/gameScreenWidth, (float)GetScreenHeight()/gameScreenHeight);
+
+        BeginTextureMode(target);
+            DrawScene();
+        EndTextureMode();
 
-        if (currentState == STATE_START)
-            DrawStartMenu();
-        else if (currentState == STATE_PLAY)
-            DrawGame();
-        else if (currentState == STATE_SERVE)
-            DrawServe();
-        else if (currentState == STATE_GAME_OVER)
-            DrawGameOver();
+        BeginDrawing();
+            ClearBackground(WHITE);
 
-        DrawFPSCustom();
-    EndTextureMode();
+            // Draw render texture to screen, properly scaled
+            DrawTexturePro(target.texture, (Rectangle){ 0.0f, 0.0f, (float)target.texture.width, (float)-target.texture.height },
+                           (Rectangle){ (GetScreenWidth() - ((float)gameScreenWidth*scale))*0.5f, (GetScreenHeight() - ((float)gameScreenHeight*scale))*0.5f,
+                           (float)gameScreenWidth*scale, (float)gameScreenHeight*scale }, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        EndDrawing();
+    }
+
+    ResetArena(&frameArena);
+}
 
-    BeginDrawing();
-        ClearBackground(WHITE);
+/* MEMORY */
+
+bool InitArenas()
+{
+    return InitArena(&permanentArena, PERMANENT_ARENA_SIZE) &&
+           InitSubArena(&levelArena, &permanentArena, LEVEL_ARENA_SIZE) &&
+           InitSubArena(&frameArena, &permanentArena, FRAME_ARENA_SIZE);
+}
 
-        // Draw render texture to screen, properly scaled
-        DrawTexturePro(target.texture, (Rectangle){ 0.0f, 0.0f, (float)target.texture.width, (float)-target.texture.height },
-                       (Rectangle){ (GetScreenWidth() - ((float)gameScreenWidth*scale))*0.5f, (GetScreenHeight() - ((float)gameScreenHeight*scale))*0.5f,
-                       (float)gameScreenWidth*scale, (float)gameScreenHeight*scale }, (Vector2){ 0, 0 }, 0.0f, WHITE);
-    EndDrawing();
+void UnloadArenas()
+{
+    UnloadArena(&frameArena);
+    UnloadArena(&levelArena);
+    UnloadArena(&permanentArena);
 }
 
 /* UPDATE FUNCTIONS */
@@ -219,137 +476,524 @@ void UpdateDrawFrame(RenderTexture2D target)
 void InitGameState()
 {
     brickCount = 0;
+    ResetBrickLive();
     level = 1;
-    health = 3;
+    health = MAX_HEALTH;
     score = 0;
+    ResetPowerups();
+}
+
+void SaveState(GameSnapshot *snapshot)
+{
+    snapshot->magic = SAVESTATE_MAGIC;
+    snapshot->version = SAVESTATE_VERSION;
+    snapshot->size = sizeof(GameSnapshot);
+    snapshot->state = currentState;
+    snapshot->versusMode = versusMode;
+    snapshot->playerPaddle = playerPaddle;
+    snapshot->opponentPaddle = opponentPaddle;
+    snapshot->balls = balls;
+    snapshot->brickCount = brickCount;
+    memcpy(snapshot->bricks, bricks, sizeof(bricks));
+    memcpy(snapshot->brickLive, brickLive, sizeof(brickLive));
+    snapshot->powerups = powerups;
+    snapshot->hasKey = hasKey;
+    snapshot->health = health;
+    snapshot->score = score;
+    snapshot->level = level;
+    snapshot->opponentHealth = opponentHealth;
+    snapshot->opponentScore = opponentScore;
+    snapshot->servingPlayer = servingPlayer;
+    snapshot->rngState = rngState;
+    snapshot->nextLevelSeed = nextLevelSeed;
 }
 
-void GameLogic(float dt)
+static bool IsValidPaddle(const Paddle *p)
 {
-    UpdatePaddle(&playerPaddle, dt);
-    UpdateBall(&ball, dt);
+    return p->skin >= 1 && p->skin <= PADDLE_SKINS && p->size >= 1 && p->size <= PADDLE_SIZES;
+}
 
-    if (ball.y >= gameScreenHeight) {
-        PlaySound(hurtSound);
-        health--;
+// Snapshots also arrive from a spectator server; every count and index the
+// game loops over or looks a sprite up with has to be in range
+static bool IsValidSnapshot(const GameSnapshot *s)
+{
+    if (s->state < STATE_START || s->state > STATE_VICTORY) return false;
+    if (!IsValidPaddle(&s->playerPaddle) || !IsValidPaddle(&s->opponentPaddle)) return false;
+    if (s->servingPlayer < 0 || s->servingPlayer > 1) return false;
+    if (s->health < 0 || s->health > MAX_HEALTH || s->opponentHealth < 0 || s->opponentHealth > MAX_HEALTH) return false;
+    if (s->level < 1) return false;
+
+    if (s->balls.count < 0 || s->balls.count > MAX_BALLS) return false;
+    for (int i = 0; i < s->balls.count; i++)
+        if (s->balls.skin[i] >= BALL_SKINS || s->balls.owner[i] > 1) return false;
+
+    if (s->brickCount < 0 || s->brickCount > MAX_BRICKS) return false;
+    for (int i = 0; i < s->brickCount; i++) {
+        const Brick *b = &s->bricks[i];
+        if (b->color < 1 || b->color > BRICK_COLORS || b->tier < 0 || b->tier >= BRICK_TIERS ||
+            b->spriteIndex != b->tier * BRICK_COLORS + (b->color - 1)) return false;
+    }
+    // Only slots below brickCount were checked, none past it may be in play
+    for (int i = s->brickCount; i < BRICK_WORDS * 64; i++)
+        if (s->brickLive[i / 64] & (1ull << (i % 64))) return false;
+
+    if (s->powerups.freeHead < -1 || s->powerups.freeHead >= MAX_POWERUPS) return false;
+    for (int i = 0; i < MAX_POWERUPS; i++) {
+        const Powerup *p = &s->powerups.items[i];
+        if (p->type < 0 || p->type >= POWERUP_TYPE_COUNT || p->next < -1 || p->next >= MAX_POWERUPS) return false;
+    }
+    return true;
+}
 
-        if (health == 0) {
-            currentState = STATE_GAME_OVER;
-        } else {
-            currentState = STATE_SERVE;
+bool LoadState(const GameSnapshot *snapshot)
+{
+    if (snapshot->magic != SAVESTATE_MAGIC || snapshot->version != SAVESTATE_VERSION ||
+        snapshot->size != sizeof(GameSnapshot)) {
+        TraceLog(LOG_WARNING, "SAVESTATE: Snapshot version or layout mismatch, ignored");
+        return false;
+    }
+    if (!IsValidSnapshot(snapshot)) {
+        TraceLog(LOG_WARNING, "SAVESTATE: Snapshot holds out-of-range values, ignored");
+        return false;
+    }
+
+    currentState = snapshot->state;
+    versusMode = snapshot->versusMode;
+    playerPaddle = snapshot->playerPaddle;
+    opponentPaddle = snapshot->opponentPaddle;
+    balls = snapshot->balls;
+    brickCount = snapshot->brickCount;
+    memcpy(bricks, snapshot->bricks, sizeof(bricks));
+    memcpy(brickLive, snapshot->brickLive, sizeof(brickLive));
+    bricksLeft = CountLiveBricks();
+    powerups = snapshot->powerups;
+    hasKey = snapshot->hasKey;
+    health = snapshot->health;
+    score = snapshot->score;
+    level = snapshot->level;
+    opponentHealth = snapshot->opponentHealth;
+    opponentScore = snapshot->opponentScore;
+    servingPlayer = snapshot->servingPlayer;
+    rngState = snapshot->rngState;
+    nextLevelSeed = snapshot->nextLevelSeed;
+    BuildBrickGrid();
+    return true;
+}
+
+// xorshift32; unlike GetRandomValue() its state is ours to save and restore
+void SeedRandom(unsigned int seed)
+{
+    rngState = seed ? seed : 1;
+}
+
+int RandomValue(int min, int max)
+{
+    return RandomFrom(&rngState, min, max);
+}
+
+unsigned int NextRandom(unsigned int *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+int RandomFrom(unsigned int *state, int min, int max)
+{
+    return min + (int)(NextRandom(state) % (unsigned int)(max - min + 1));
+}
+
+PaddleInput ReadPaddleInput()
+{
+    PaddleInput input = 0;
+    if (IsKeyDown(KEY_LEFT)) input |= INPUT_LEFT;
+    if (IsKeyDown(KEY_RIGHT)) input |= INPUT_RIGHT;
+    if (IsKeyPressed(KEY_ENTER)) input |= INPUT_SERVE;
+    return input;
+}
+
+// Queued with its horizontal position, the mixer pans and merges at the end of the frame
+void PlaySimSound(Sound sound, float x)
+{
+    if (!isResimulating) PushAudioEvent(sound, x / gameScreenWidth * 2.0f - 1.0f);
+}
+
+// One deterministic step of the match, driven only by inputs and dt
+void SimulateTick(const PaddleInput *inputs, float dt)
+{
+    switch (currentState) {
+        case STATE_SERVE:
+            ServeState(inputs, dt);
+            break;
+        case STATE_PLAY:
+            GameLogic(inputs, dt);
+            break;
+        case STATE_GAME_OVER:
+            if (versusMode) VersusGameOverState(inputs);
+            break;
+        case STATE_VICTORY:
+            VictoryState(inputs, dt);
+            break;
+        default:
+            break;
+    }
+}
+
+void StartVersusMatch(unsigned int seed)
+{
+    versusMode = true;
+    SeedRandom(seed);
+
+    InitGameState();
+    opponentHealth = MAX_HEALTH;
+    opponentScore = 0;
+    servingPlayer = 0;
+
+    InitPaddle(&playerPaddle);
+    InitPaddle(&opponentPaddle);
+    opponentPaddle.y = VERSUS_PADDLE_Y;
+    opponentPaddle.skin = 2;
+    ResetBalls();
+    InitBricks();
+
+    currentState = STATE_SERVE;
+}
+
+void VersusGameOverState(const PaddleInput *inputs)
+{
+    if ((inputs[0] | inputs[1]) & INPUT_SERVE) {
+        // Rematch continues from the current RNG state, same on both peers
+        StartVersusMatch(rngState);
+    }
+}
+
+void LoseBall(int player, float x)
+{
+    PlaySimSound(hurtSound, x);
+    ResetBalls();
+
+    // Losing a ball costs a paddle size, as catching a grow pickup gave one
+    if (!versusMode && player == 0 && playerPaddle.size > 1) {
+        playerPaddle.size--;
+        playerPaddle.width -= 32;
+    }
+
+    int *lives = (player == 1) ? &opponentHealth : &health;
+    (*lives)--;
+    servingPlayer = player;
+
+    if (*lives == 0) {
+        currentState = STATE_GAME_OVER;
+        if (!versusMode && SubmitHighScore(score, level) >= 0)
+            PlaySimSound(highScoreSound, gameScreenWidth / 2.0f);
+    } else {
+        currentState = STATE_SERVE;
+    }
+}
+
+void GameLogic(const PaddleInput *inputs, float dt)
+{
+    UpdatePaddle(&playerPaddle, inputs[0], dt);
+    if (versusMode) UpdatePaddle(&opponentPaddle, inputs[1], dt);
+    UpdateBalls(dt);
+
+    // Balls past a goal line leave play, the last one out costs that player a life
+    for (int i = balls.count - 1; i >= 0; i--) {
+        int goal = -1;
+        if (balls.y[i] >= gameScreenHeight) goal = 0;
+        else if (versusMode && balls.y[i] + BALL_SIZE <= 0) goal = 1;
+        if (goal < 0) continue;
+
+        float x = balls.x[i] + BALL_SIZE / 2;
+        RemoveBall(i);
+        if (balls.count == 0) {
+            LoseBall(goal, x);
+            return;
         }
     }
 
     // Ball-Paddle Collision
-    Rectangle ballRect = { ball.x, ball.y, ball.width, ball.height };
-    Rectangle paddleRect = { playerPaddle.x, playerPaddle.y, (float)playerPaddle.width, (float)playerPaddle.height };
-    if (CheckCollisionRecs(ballRect, paddleRect))
-        HandleBallPaddleCollision(&ball, &playerPaddle);
+    CollideBallsWithPaddle(&playerPaddle, 0);
+    if (versusMode) CollideBallsWithPaddle(&opponentPaddle, 1);
 
-    // Ball-Brick Collision with Edge Detection
-    for (int i = 0; i < brickCount; i++) {
-        if (bricks[i].inPlay) {
-            Rectangle ballRect = { ball.x, ball.y, ball.width, ball.height };
-            Rectangle brickRect = { bricks[i].x, bricks[i].y, bricks[i].width, bricks[i].height };
-            if (CheckCollisionRecs(ballRect, brickRect)) {
-                HandleBallBrickCollision(&ball, &bricks[i]);
-                break; // tylko jedna kolizja w jednej klatce
-            }
-        }
+    // Ball-Brick Collision, only the cells each ball overlaps and one brick per ball per tick
+    for (int i = 0; i < balls.count; i++) {
+        int hit = FindBrick(balls.x[i], balls.y[i], BALL_SIZE, BALL_SIZE);
+        if (hit >= 0) HandleBallBrickCollision(i, hit);
+    }
+
+    if (bricksLeft == 0) {
+        LevelCleared();
+        return;
+    }
+
+    UpdatePowerups(dt);
+    ApplyEffects();
+}
+
+void CollideBallsWithPaddle(Paddle *paddle, int player)
+{
+    // CheckCollisionRecs() with the ball size folded into the paddle bounds;
+    // the test pass has no calls or early exits so it vectorizes
+    float left = paddle->x - BALL_SIZE;
+    float right = paddle->x + paddle->width;
+    float top = paddle->y - BALL_SIZE;
+    float bottom = paddle->y + paddle->height;
+
+    int hits = 0;
+    for (int i = 0; i < balls.count; i++) {
+        bool hit = balls.x[i] > left && balls.x[i] < right && balls.y[i] > top && balls.y[i] < bottom;
+        ballHits[i] = hit;
+        hits += hit;
+    }
+    if (hits == 0) return;
+
+    for (int i = 0; i < balls.count; i++) {
+        if (!ballHits[i]) continue;
+        HandleBallPaddleCollision(i, paddle);
+        balls.owner[i] = player;
     }
 }
 
-void HandleBallPaddleCollision(Ball *ball, Paddle *playerPaddle)
+void HandleBallPaddleCollision(int i, Paddle *playerPaddle)
 {
-    ball->y = playerPaddle->y - ball->height;
-    ball->dy = -ball->dy;
+    // The versus top paddle sends the ball back down
+    if (playerPaddle->y < gameScreenHeight / 2)
+        balls.y[i] = playerPaddle->y + playerPaddle->height;
+    else
+        balls.y[i] = playerPaddle->y - BALL_SIZE;
+    balls.dy[i] = -balls.dy[i];
 
     float paddleCenter = playerPaddle->x + playerPaddle->width / 2.0f;
-    float ballCenter = ball->x + ball->width / 2;
+    float ballCenter = balls.x[i] + BALL_SIZE / 2;
     float diff = paddleCenter - ballCenter;
 
     if (ballCenter < paddleCenter && playerPaddle->dx < 0) {
-        ball->dx = -50.0f - 8.0f * fabsf(diff);
+        balls.dx[i] = -50.0f - 8.0f * fabsf(diff);
     } else if (ballCenter > paddleCenter && playerPaddle->dx > 0) {
-        ball->dx = 50.0f + 8.0f * fabsf(diff);
+        balls.dx[i] = 50.0f + 8.0f * fabsf(diff);
     }
 
-    PlaySound(paddleHitSound);
+    PlaySimSound(paddleHitSound, ballCenter);
 }
 
-void HandleBallBrickCollision(Ball *ball, Brick *brick)
-{    
+void HandleBallBrickCollision(int i, int b)
+{
+    Brick *brick = &bricks[b];
+
     // SCORING
-    score += (brick->tier * 200 + brick->color * 25);
-    // if we're at a higher tier than the base, we need to go down a tier
-    // if we're already at the lowest color, else just go down a color
-    if (brick->tier > 0) {
-        if (brick->color == 1) {
-            brick->tier--;
-            brick->color = 5;
-        } else {
-            brick->color--;
+    int *points = (versusMode && balls.owner[i] == 1) ? &opponentScore : &score;
+    if (brick->locked) {
+        // a locked brick just bounces the ball until the key is collected
+        if (hasKey) {
+            *points += LOCKED_BRICK_POINTS;
+            KillBrick(b);
+        }
+    } else {
+        *points += (brick->tier * 200 + brick->color * 25);
+        // if we're at a higher tier than the base, we need to go down a tier
+        // if we're already at the lowest color, else just go down a color
+        if (brick->tier > 0) {
+            if (brick->color == 1) {
+                brick->tier--;
+                brick->color = 5;
+            } else {
+                brick->color--;
+            }
+        }
+        else {
+            // if we're in the first tier and the base color, remove brick from play
+            if (brick->color == 1)
+                KillBrick(b);
+            else
+                brick->color--;
         }
-    }
-    else {
-        // if we're in the first tier and the base color, remove brick from play
-        if (brick->color == 1)
-            brick->inPlay = false;
-        else
-            brick->color--;
     }
 
     // TraceLog(LOG_DEBUG, "Brick hit: index=%d, color=%d, tier=%d, inPlay=%s",
-    //          i, brick->color, brick->tier, brick->inPlay ? "true" : "false");
+    //          b, brick->color, brick->tier, IsBrickLive(b) ? "true" : "false");
 
 
     // play a second layer sound if the brick is destroyed
-    if (!brick->inPlay) {
-        PlaySound(brickHit1Sound);
+    float brickCenter = brick->x + brick->width / 2.0f;
+    if (!IsBrickLive(b)) {
+        PlaySimSound(brickHit1Sound, brickCenter);
     } else {
-        PlaySound(brickHit2Sound);
+        PlaySimSound(brickHit2Sound, brickCenter);
     }
 
+    DropPowerup(brick);
 
-    if (ball->x + ball->width - 1 < brick->x && ball->dx > 0) {
+    if (balls.x[i] + BALL_SIZE - 1 < brick->x && balls.dx[i] > 0) {
         // Hit left side
-        ball->dx = -ball->dx;
-        ball->x = brick->x - ball->width;
-    } else if (ball->x + 1 > brick->x + brick->width && ball->dx < 0) {
+        balls.dx[i] = -balls.dx[i];
+        balls.x[i] = brick->x - BALL_SIZE;
+    } else if (balls.x[i] + 1 > brick->x + brick->width && balls.dx[i] < 0) {
         // Hit right side
-        ball->dx = -ball->dx;
-        ball->x = brick->x + brick->width;
-    } else if (ball->y < brick->y) {
+        balls.dx[i] = -balls.dx[i];
+        balls.x[i] = brick->x + brick->width;
+    } else if (balls.y[i] < brick->y) {
         // Hit top of brick, ball going down
-        ball->dy = -ball->dy;
-        ball->y = brick->y - ball->height;
+        balls.dy[i] = -balls.dy[i];
+        balls.y[i] = brick->y - BALL_SIZE;
     } else {
         // Hit bottom of brick, ball going up
-        ball->dy = -ball->dy;
-        ball->y = brick->y + brick->height;
+        balls.dy[i] = -balls.dy[i];
+        balls.y[i] = brick->y + brick->height;
     }
 
     // slight speed up
-    ball->dy *= 1.02f;
+    balls.dy[i] *= 1.02f;
 
     brick->spriteIndex = brick->tier * 5 + (brick->color - 1);
 }
 
+void InitPowerupQuads()
+{
+    // Icons along y = 192 in the sheet, the key is the last of the ten
+    static const int icons[POWERUP_TYPE_COUNT] = { 3, 8, 9 };
+    for (int i = 0; i < POWERUP_TYPE_COUNT; i++)
+        powerupQuads[i] = (Rectangle){ icons[i] * POWERUP_SIZE, 192, POWERUP_SIZE, POWERUP_SIZE };
+}
+
+void ResetPowerups()
+{
+    for (int i = 0; i < MAX_POWERUPS; i++) {
+        powerups.items[i].active = false;
+        powerups.items[i].next = (i + 1 < MAX_POWERUPS) ? i + 1 : -1;
+    }
+    powerups.freeHead = 0;
+    effects.count = 0;
+}
+
+int SpawnPowerup(PowerupType type, float x, float y)
+{
+    int i = powerups.freeHead;
+    if (i < 0) return -1;
+
+    powerups.freeHead = powerups.items[i].next;
+    powerups.items[i] = (Powerup){ .x = x, .y = y, .type = type, .active = true, .next = -1 };
+    return i;
+}
+
+void FreePowerup(int i)
+{
+    powerups.items[i].active = false;
+    powerups.items[i].next = powerups.freeHead;
+    powerups.freeHead = i;
+}
+
+void DropPowerup(const Brick *brick)
+{
+    // Single player only, the pickups fall towards the bottom paddle
+    if (versusMode || RandomValue(1, 100) > POWERUP_DROP_CHANCE) return;
+
+    PowerupType type = RandomValue(0, 1) ? POWERUP_MULTIBALL : POWERUP_GROW;
+    if (!hasKey && RandomValue(1, 3) == 1) {
+        for (int i = NextLiveBrick(0); i >= 0; i = NextLiveBrick(i + 1)) {
+            if (bricks[i].locked) {
+                type = POWERUP_KEY;
+                break;
+            }
+        }
+    }
+    SpawnPowerup(type, brick->x + (brick->width - POWERUP_SIZE) / 2, brick->y);
+}
+
+void UpdatePowerups(float dt)
+{
+    Rectangle paddleRect = { playerPaddle.x, playerPaddle.y, (float)playerPaddle.width, (float)playerPaddle.height };
+
+    for (int i = 0; i < MAX_POWERUPS; i++) {
+        Powerup *p = &powerups.items[i];
+        if (!p->active) continue;
+
+        p->y += POWERUP_SPEED * dt;
+        if (CheckCollisionRecs((Rectangle){ p->x, p->y, POWERUP_SIZE, POWERUP_SIZE }, paddleRect)) {
+            PlaySimSound(recoverSound, p->x + POWERUP_SIZE / 2);
+            QueueEffect(p->type);
+            FreePowerup(i);
+        } else if (p->y >= gameScreenHeight) {
+            FreePowerup(i);
+        }
+    }
+}
+
+void QueueEffect(PowerupType type)
+{
+    if (effects.count < MAX_POWERUP_EFFECTS) effects.items[effects.count++] = type;
+}
+
+void ApplyEffects()
+{
+    for (int e = 0; e < effects.count; e++) {
+        switch (effects.items[e]) {
+            case POWERUP_GROW:
+                if (playerPaddle.size < PADDLE_SIZES) {
+                    playerPaddle.size++;
+                    playerPaddle.width += 32;
+                    playerPaddle.x = MAX(0, playerPaddle.x - 16);
+                }
+                break;
+            case POWERUP_MULTIBALL:
+                for (int k = 0; k < MULTIBALL_EXTRA_BALLS; k++) {
+                    float x = playerPaddle.x + playerPaddle.width / 2.0f - BALL_SIZE / 2;
+                    int b = SpawnBall(x, playerPaddle.y - BALL_SIZE, RandomValue(-200, 200), -RandomValue(50, 60), 0);
+                    if (b >= 0) balls.skin[b] = RandomValue(1, 6);
+                }
+                break;
+            case POWERUP_KEY:
+                hasKey = true;
+                break;
+            default:
+                break;
+        }
+    }
+    effects.count = 0;
+}
+
+void UpdateRewind()
+{
+    // Shift scrubs continuously, otherwise one tick per press (with key repeat)
+    bool scrub = IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT);
+    bool back = scrub ? IsKeyDown(KEY_LEFT) : (IsKeyPressed(KEY_LEFT) || IsKeyPressedRepeat(KEY_LEFT));
+    bool forward = scrub ? IsKeyDown(KEY_RIGHT) : (IsKeyPressed(KEY_RIGHT) || IsKeyPressedRepeat(KEY_RIGHT));
+
+    int frames = RewindFrameCount(&rewindBuffer);
+    if (back) rewindCursor++;
+    if (forward) rewindCursor--;
+    rewindCursor = MAX(0, MIN(rewindCursor, frames - 1));
+
+    if (RewindGet(&rewindBuffer, rewindCursor, &rewindFrame))
+        LoadState(&rewindFrame);
+}
+
 void UpdateStartMenu()
 {
     if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_DOWN)) {
         startMenu.highlighted = (startMenu.highlighted == 1) ? 2 : 1;
-        PlaySound(paddleHitSound);
+        PlayVoice(paddleHitSound);
     }
 
     if (IsKeyPressed(KEY_ENTER)) {
-        PlaySound(confirmSound);
+        PlayVoice(confirmSound);
         if (startMenu.highlighted == 1) {
             currentState = STATE_SERVE;
+        } else if (startMenu.highlighted == 2) {
+            currentState = STATE_HIGH_SCORES;
         }
     }
 }
 
+void UpdateHighScores()
+{
+    if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_BACKSPACE)) {
+        PlayVoice(selectSound);
+        currentState = STATE_START;
+    }
+}
+
 void InitPaddleQuads()
 {
     int counter = 0;
@@ -374,11 +1018,11 @@ void InitPaddle(Paddle *p)
     p->size = 2;
 }
 
-void UpdatePaddle(Paddle *p, float dt)
+void UpdatePaddle(Paddle *p, PaddleInput input, float dt)
 {
-    if (IsKeyDown(KEY_LEFT)) {
+    if (input & INPUT_LEFT) {
         p->dx = -PADDLE_SPEED;
-    } else if (IsKeyDown(KEY_RIGHT)) {
+    } else if (input & INPUT_RIGHT) {
         p->dx = PADDLE_SPEED;
     } else {
         p->dx = 0;
@@ -396,44 +1040,90 @@ void InitBallQuads()
     int count = 0;
     for (int j = 0; j < 2; j++) {
         for (int i = 0; i < 4; i++) {
-            if (count < 7) {
+            if (count < BALL_SKINS) {
                 ballQuads[count++] = (Rectangle){ x + i * 8, y + j * 8, 8, 8 };
             }
         }
     }
 }
 
-void InitBall(Ball *b)
+// A single ball at rest; serving gives it a velocity
+void ResetBalls()
 {
-    b->x = gameScreenWidth / 2 - 4;
-    b->y = gameScreenHeight / 2 - 4;
-    b->dx = GetRandomValue(-200, 200);
-    b->dy = GetRandomValue(-60, -50);
-    b->width = 8;
-    b->height = 8;
-    b->skin = 0;
+    balls.count = 0;
+    SpawnBall(gameScreenWidth / 2 - BALL_SIZE / 2, gameScreenHeight / 2 - BALL_SIZE / 2, 0.0f, 0.0f, 0);
 }
 
-void UpdateBall(Ball *b, float dt)
+int SpawnBall(float x, float y, float dx, float dy, int owner)
 {
-    b->x += b->dx * dt;
-    b->y += b->dy * dt;
+    if (balls.count >= MAX_BALLS) return -1;
+
+    int i = balls.count++;
+    balls.x[i] = x;
+    balls.y[i] = y;
+    balls.dx[i] = dx;
+    balls.dy[i] = dy;
+    balls.skin[i] = 0;
+    balls.owner[i] = (unsigned char)owner;
+    return i;
+}
 
-    if (b->x <= 0) {
-        b->x = 0;
-        b->dx = -b->dx;
-        PlaySound(wallHitSound);
-    } else if (b->x + b->width >= gameScreenWidth) {
-        b->x = gameScreenWidth - b->width;
-        b->dx = -b->dx;
-        PlaySound(wallHitSound);
+// Every ball in play gets copies fanned out in random directions, keeping its vertical heading
+void SplitBalls(int copies)
+{
+    int count = balls.count;
+    for (int i = 0; i < count; i++) {
+        for (int c = 0; c < copies; c++) {
+            float dy = fabsf(balls.dy[i]) + RandomValue(0, 20);
+            int j = SpawnBall(balls.x[i], balls.y[i], RandomValue(-200, 200), balls.dy[i] < 0 ? -dy : dy, balls.owner[i]);
+            if (j < 0) return;
+            balls.skin[j] = RandomValue(1, 6);
+        }
     }
+}
 
-    if (b->y <= 0) {
-        b->y = 0;
-        b->dy = -b->dy;
-        PlaySound(wallHitSound);
+void RemoveBall(int i)
+{
+    int last = --balls.count;
+    balls.x[i] = balls.x[last];
+    balls.y[i] = balls.y[last];
+    balls.dx[i] = balls.dx[last];
+    balls.dy[i] = balls.dy[last];
+    balls.skin[i] = balls.skin[last];
+    balls.owner[i] = balls.owner[last];
+}
+
+void UpdateBalls(float dt)
+{
+    float *x = balls.x, *y = balls.y, *dx = balls.dx, *dy = balls.dy;
+    float right = gameScreenWidth - BALL_SIZE;
+    float top = versusMode ? -INFINITY : 0.0f;  // In versus the top edge is player 2's goal
+
+    // Branch-free so the whole pass vectorizes; bounces are only counted here
+    // and turned into at most one sound per wall below
+    int leftHits = 0, rightHits = 0, topHits = 0, topHitX = 0;
+    for (int i = 0; i < balls.count; i++) {
+        x[i] += dx[i] * dt;
+        y[i] += dy[i] * dt;
+
+        bool hitLeft = x[i] <= 0;
+        bool hitRight = !hitLeft && x[i] >= right;
+        bool hitTop = y[i] <= top;
+
+        x[i] = hitLeft ? 0.0f : (hitRight ? right : x[i]);
+        dx[i] = (hitLeft || hitRight) ? -dx[i] : dx[i];
+        y[i] = hitTop ? 0.0f : y[i];
+        dy[i] = hitTop ? -dy[i] : dy[i];
+
+        leftHits += hitLeft;
+        rightHits += hitRight;
+        topHits += hitTop;
+        topHitX += hitTop ? (int)x[i] : 0;
     }
+
+    if (leftHits) PlaySimSound(wallHitSound, 0.0f);
+    if (rightHits) PlaySimSound(wallHitSound, gameScreenWidth);
+    if (topHits) PlaySimSound(wallHitSound, (float)topHitX / topHits + BALL_SIZE / 2);
 }
 
 void InitBrickQuads()
@@ -447,105 +1137,205 @@ void InitBrickQuads()
 }
 
 
+static void InstallLevel(const LevelLayout *layout)
+{
+    brickCount = layout->count;
+    memcpy(bricks, layout->bricks, layout->count * sizeof(Brick));
+    hasKey = false;
+    ResetBrickLive();
+    BuildBrickGrid();
+
+    // The following wall is built off the frame while this one is played
+    nextLevelSeed = NextRandom(&rngState);
+    RequestLevel(level + 1, versusMode, nextLevelSeed);
+}
+
+// Everything a wall needs lives in the level arena until the next one replaces it
+static LevelLayout *NewLevelLayout(void)
+{
+    ResetArena(&levelArena);
+    return ArenaAlloc(&levelArena, sizeof(LevelLayout));
+}
+
 void InitBricks()
 {
-    brickCount = 0;
-    int numRows = GetRandomValue(3, 5);
-    int numCols = GetRandomValue(7, 13);
-    if (numCols % 2 == 0) numCols++; // ensure columns odd
+    LevelLayout *layout = NewLevelLayout();
+    BuildLevel(layout, level, versusMode, NextRandom(&rngState));
+    InstallLevel(layout);
+}
 
-    // Level-dependent color/tier richness
-    int highestTier = MIN(3, (int)floor(level / 5.0f));
-    int highestColor = MIN(3, level % 5 + 3);
+void AdvanceLevel()
+{
+    LevelLayout *layout = NewLevelLayout();
+    level++;
+    TakeLevel(layout, level, versusMode, nextLevelSeed);
+    InstallLevel(layout);
+}
 
-    for (int y = 0; y < numRows; y++) {
+void BuildBrickGrid()
+{
+    for (int r = 0; r < BRICK_GRID_ROWS; r++)
+        for (int c = 0; c < BRICK_GRID_COLS; c++)
+            brickGrid[r][c] = -1;
 
-        bool skipPattern = GetRandomValue(0, 1) == 1;
-        bool alternatePattern = GetRandomValue(0, 1) == 1;
+    // Rows start wherever the wall does, versus centers it vertically
+    brickGridY = (brickCount > 0) ? fmodf(bricks[0].y, BRICK_HEIGHT) : 0.0f;
 
-        int alternateColor1 = GetRandomValue(1, highestColor);
-        int alternateColor2 = GetRandomValue(1, highestColor);
-        int alternateTier1 = GetRandomValue(0, highestTier);
-        int alternateTier2 = GetRandomValue(0, highestTier);
+    for (int i = 0; i < brickCount; i++) {
+        float col = (bricks[i].x - BRICK_GRID_X) / BRICK_WIDTH;
+        float row = (bricks[i].y - brickGridY) / BRICK_HEIGHT;
+
+        // Exactly one cell per brick: a ball could never find a brick off the lattice,
+        // so it would stay in play and the wall could not be cleared
+        bool placed = col >= 0 && col < BRICK_GRID_COLS && row >= 0 && row < BRICK_GRID_ROWS &&
+                      col == floorf(col) && row == floorf(row) &&
+                      bricks[i].width == BRICK_WIDTH && bricks[i].height == BRICK_HEIGHT;
+        int c = placed ? (int)col : 0;
+        int r = placed ? (int)row : 0;
+        if (!placed || brickGrid[r][c] != -1) {
+            TraceLog(LOG_WARNING, "BRICKS: Brick %d at %.0f,%.0f is off the grid, removed", i, bricks[i].x, bricks[i].y);
+            KillBrick(i);
+            continue;
+        }
+        brickGrid[r][c] = (short)i;
+    }
+}
 
-        bool skipFlag = GetRandomValue(0, 1) == 1;
-        bool alternateFlag = GetRandomValue(0, 1) == 1;
+#if defined(__GNUC__)
+    #define PopCount64(x) __builtin_popcountll(x)
+    #define TrailingZeros64(x) __builtin_ctzll(x)
+#else
+static int PopCount64(uint64_t x)
+{
+    int n = 0;
+    for (; x; x &= x - 1) n++;
+    return n;
+}
 
-        int solidColor = GetRandomValue(1, highestColor);
-        int solidTier = GetRandomValue(0, highestTier);
+static int TrailingZeros64(uint64_t x)
+{
+    int n = 0;
+    for (; !(x & 1); x >>= 1) n++;
+    return n;
+}
+#endif
 
-        for (int x = 0; x < numCols; x++) {
-            if (brickCount >= MAX_BRICKS) break;
+void ResetBrickLive()
+{
+    memset(brickLive, 0, sizeof(brickLive));
+    for (int i = 0; i < brickCount; i++) brickLive[i / 64] |= 1ull << (i % 64);
+    bricksLeft = brickCount;
+}
 
-            if (skipPattern && skipFlag) {
-                skipFlag = !skipFlag;
-                continue;
-            } else {
-                skipFlag = !skipFlag;
-            }
+bool IsBrickLive(int i)
+{
+    return (brickLive[i / 64] >> (i % 64)) & 1;
+}
 
-            float bx = x * BRICK_WIDTH + 8 + (13 - numCols) * 16;
-            float by = (y + 1) * BRICK_HEIGHT;
-
-            int color, tier;
-            if (alternatePattern) {
-                if (alternateFlag) {
-                    color = alternateColor1;
-                    tier = alternateTier1;
-                } else {
-                    color = alternateColor2;
-                    tier = alternateTier2;
-                }
-                alternateFlag = !alternateFlag;
-            } else {
-                color = solidColor;
-                tier = solidTier;
-            }
+void KillBrick(int i)
+{
+    if (!IsBrickLive(i)) return;
+    brickLive[i / 64] &= ~(1ull << (i % 64));
+    bricksLeft--;
+}
 
-            int spriteIndex = tier * 5 + (color - 1); // 5 colors (columns) × 4 tiers (rows) = 20 sprites
-
-            bricks[brickCount++] = (Brick){
-                .x = bx,
-                .y = by,
-                .width = BRICK_WIDTH,
-                .height = BRICK_HEIGHT,
-                .inPlay = true,
-                .color = color,
-                .tier = tier,
-                .spriteIndex = spriteIndex
-            };
-            TraceLog(LOG_DEBUG, "Brick %d → color=%d, tier=%d, spriteIndex=%d",
-                     brickCount, color, tier, spriteIndex);
+int NextLiveBrick(int from)
+{
+    for (int w = from / 64; w < BRICK_WORDS; w++) {
+        uint64_t bits = brickLive[w];
+        if (w == from / 64) bits &= ~0ull << (from % 64);
+        if (bits) return w * 64 + TrailingZeros64(bits);
+    }
+    return -1;
+}
+
+int CountLiveBricks()
+{
+    int n = 0;
+    for (int w = 0; w < BRICK_WORDS; w++) n += PopCount64(brickLive[w]);
+    return n;
+}
+
+void LevelCleared()
+{
+    PlaySimSound(victorySound, gameScreenWidth / 2.0f);
+    ResetBalls();
+    ResetPowerups();
+    currentState = STATE_VICTORY;
+}
+
+int FindBrick(float x, float y, float width, float height)
+{
+    int c0 = MAX(0, (int)floorf((x - BRICK_GRID_X) / BRICK_WIDTH));
+    int c1 = MIN(BRICK_GRID_COLS - 1, (int)floorf((x + width - BRICK_GRID_X) / BRICK_WIDTH));
+    int r0 = MAX(0, (int)floorf((y - brickGridY) / BRICK_HEIGHT));
+    int r1 = MIN(BRICK_GRID_ROWS - 1, (int)floorf((y + height - brickGridY) / BRICK_HEIGHT));
+
+    // Lowest index wins, the order the old linear scan would have found them in
+    Rectangle rect = { x, y, width, height };
+    int found = -1;
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int i = brickGrid[r][c];
+            if (i < 0 || !IsBrickLive(i) || (found >= 0 && i > found)) continue;
+
+            Rectangle brickRect = { bricks[i].x, bricks[i].y, bricks[i].width, bricks[i].height };
+            if (CheckCollisionRecs(rect, brickRect)) found = i;
         }
     }
+    return found;
 }
 
-void ServeState(float dt) {
+void ServeState(const PaddleInput *inputs, float dt) {
     // Paddle movement
-    UpdatePaddle(&playerPaddle, dt);
+    UpdatePaddle(&playerPaddle, inputs[0], dt);
+    if (versusMode) UpdatePaddle(&opponentPaddle, inputs[1], dt);
 
-    // Place ball above paddle
-    ball.x = playerPaddle.x + (playerPaddle.width / 2) - (ball.width / 2);
-    ball.y = playerPaddle.y - ball.height;
+    // Place ball on the serving paddle
+    Paddle *server = (servingPlayer == 1) ? &opponentPaddle : &playerPaddle;
+    balls.x[0] = server->x + (server->width / 2) - (BALL_SIZE / 2);
+    balls.y[0] = (servingPlayer == 1) ? server->y + server->height : server->y - BALL_SIZE;
 
     // Wait for enter to serve
-    if (IsKeyPressed(KEY_ENTER)) {
+    if (inputs[servingPlayer] & INPUT_SERVE) {
         // Give ball a new velocity
-        ball.dx = GetRandomValue(-200, 200);
-        ball.dy = GetRandomValue(-60, -50);
+        balls.dx[0] = RandomValue(-200, 200);
+        balls.dy[0] = RandomValue(-60, -50);
+        if (servingPlayer == 1) balls.dy[0] = -balls.dy[0];
+        balls.owner[0] = servingPlayer;
         currentState = STATE_PLAY;
     }
 }
 
+void VictoryState(const PaddleInput *inputs, float dt)
+{
+    UpdatePaddle(&playerPaddle, inputs[0], dt);
+    if (versusMode) UpdatePaddle(&opponentPaddle, inputs[1], dt);
+
+    // The ball waits on the serving paddle, as it will in the next level
+    Paddle *server = (servingPlayer == 1) ? &opponentPaddle : &playerPaddle;
+    balls.x[0] = server->x + (server->width / 2) - (BALL_SIZE / 2);
+    balls.y[0] = (servingPlayer == 1) ? server->y + server->height : server->y - BALL_SIZE;
+
+    // The next wall was built while this one was played, switching is a copy
+    if (inputs[servingPlayer] & INPUT_SERVE) {
+        AdvanceLevel();
+        currentState = STATE_SERVE;
+    }
+}
+
 void GameOverState()
 {
     if (IsKeyPressed(KEY_ENTER)) {
         // Reset game state to initial values
-        health = 3;
+        health = MAX_HEALTH;
         score = 0;
         InitPaddle(&playerPaddle);
-        InitBall(&ball);
-        level++; InitBricks();
+        ResetBalls();
+        ResetPowerups();
+        level = 1;
+        InitBricks();
+        ClearRewind(&rewindBuffer);
         currentState = STATE_START;
     }
 }
@@ -554,116 +1344,146 @@ void GameOverState()
 
 void DrawFPSCustom()
 {
-    char fpsText[16];
-    sprintf(fpsText, "%d FPS", GetFPS());
-    DrawTextEx(smallFont, fpsText, (Vector2){5, 5}, 8, 1, GREEN);
+    char fpsText[48];
+    int length = sprintf(fpsText, "%d FPS", GetFPS());
+    if (balls.count > 1) length += sprintf(fpsText + length, "  %d balls", balls.count);
+    if (turboTicks > 1) sprintf(fpsText + length, "  turbo x%d", turboTicks);
+    DrawFontText(gameFont, fpsText, (Vector2){5, 5}, 8, 1, GREEN);
 }
 
 void DrawStartMenu()
 {
     // Title
     const char *title = "BREAKOUT";
-    Vector2 titleSize = MeasureTextEx(largeFont, title, 32, 1);
+    Vector2 titleSize = MeasureFontText(gameFont, title, 32, 1);
     float titleX = (gameScreenWidth - titleSize.x) / 2;
     float titleY = gameScreenHeight / 3;
-    DrawTextEx(largeFont, title, (Vector2){titleX, titleY}, 32, 1, WHITE);
+    DrawFontText(gameFont, title, (Vector2){titleX, titleY}, 32, 1, WHITE);
 
     // Option 1: START
     const char *startText = "START";
-    Vector2 startSize = MeasureTextEx(mediumFont, startText, 16, 1);
+    Vector2 startSize = MeasureFontText(gameFont, startText, 16, 1);
     float startX = (gameScreenWidth - startSize.x) / 2;
     float startY = gameScreenHeight / 2 + 70;
 
     Color startColor = (startMenu.highlighted == 1) ? (Color){103, 255, 255, 255} : WHITE;
-    DrawTextEx(mediumFont, startText, (Vector2){startX, startY}, 16, 1, startColor);
+    DrawFontText(gameFont, startText, (Vector2){startX, startY}, 16, 1, startColor);
 
     // Option 2: HIGH SCORES
     const char *scoreText = "HIGH SCORES";
-    Vector2 scoreSize = MeasureTextEx(mediumFont, scoreText, 16, 1);
+    Vector2 scoreSize = MeasureFontText(gameFont, scoreText, 16, 1);
     float scoreX = (gameScreenWidth - scoreSize.x) / 2;
     float scoreY = gameScreenHeight / 2 + 90;
 
     Color scoreColor = (startMenu.highlighted == 2) ? (Color){103, 255, 255, 255} : WHITE;
-    DrawTextEx(mediumFont, scoreText, (Vector2){scoreX, scoreY}, 16, 1, scoreColor);
+    DrawFontText(gameFont, scoreText, (Vector2){scoreX, scoreY}, 16, 1, scoreColor);
 }
 
 void DrawGame()
 {
     DrawPaddle(&playerPaddle);
-    DrawBall(&ball);
+    if (versusMode) DrawPaddle(&opponentPaddle);
+    DrawBalls();
     DrawBricks();
+    DrawPowerups();
 
     DrawHealth();
-
-    Vector2 scorePosition = {gameScreenWidth - 60, 5};
-    DrawTextEx(smallFont, TextFormat("Score: %d", score), scorePosition, 8, 1, WHITE);
+    DrawScoreLine();
 
     if (isPaused)
     {
         const char *msg = "PAUSED";
-        Vector2 size = MeasureTextEx(largeFont, msg, 32, 1);
+        Vector2 size = MeasureFontText(gameFont, msg, 32, 1);
         Vector2 position = { (gameScreenWidth - size.x)/2, gameScreenHeight/2 - 16 };
-        DrawTextEx(largeFont, msg, position, 32, 1, blueColor);
+        DrawFontText(gameFont, msg, position, 32, 1, blueColor);
     }
 }
 
-void DrawBall(Ball *b)
+void DrawBalls()
 {
-    DrawTextureRec(mainTexture, ballQuads[b->skin], (Vector2){ b->x, b->y }, WHITE);
+    // Same texture throughout, so raylib batches these into few draw calls
+    for (int i = 0; i < balls.count; i++)
+        DrawTextureRec(GetTexture(mainTexture), ballQuads[balls.skin[i]], (Vector2){ balls.x[i], balls.y[i] }, WHITE);
 }
 
 void DrawPaddle(Paddle *p)
 {
     int index = (p->size - 1) + 4 * (p->skin - 1);
-    DrawTextureRec(mainTexture, paddleQuads[index], (Vector2){ p->x, p->y }, WHITE);
+    DrawTextureRec(GetTexture(mainTexture), paddleQuads[index], (Vector2){ p->x, p->y }, WHITE);
 }
 
 void DrawBricks()
 {
-    for (int i = 0; i < brickCount; i++) {
-        if (bricks[i].inPlay) {
-            DrawTextureRec(
-            mainTexture,
-            brickQuads[bricks[i].spriteIndex],
+    for (int i = NextLiveBrick(0); i >= 0; i = NextLiveBrick(i + 1)) {
+        DrawTextureRec(
+            GetTexture(mainTexture),
+            bricks[i].locked ? lockedBrickQuad : brickQuads[bricks[i].spriteIndex],
             (Vector2){ bricks[i].x, bricks[i].y },
             WHITE
         );
-        }
     }
 }
 
-void DrawHealth()
+void DrawPowerups()
+{
+    for (int i = 0; i < MAX_POWERUPS; i++) {
+        const Powerup *p = &powerups.items[i];
+        if (p->active)
+            DrawTextureRec(GetTexture(mainTexture), powerupQuads[p->type], (Vector2){ p->x, p->y }, WHITE);
+    }
+}
+
+static void DrawHearts(float x, int lives)
 {
     // The first frame is a full heart, the second is an empty heart.
     Rectangle fullHeart = { 0, 0, 10, 9 };
     Rectangle emptyHeart = { 10, 0, 10, 9 };
-    float x = gameScreenWidth - 100;
-    for (int i = 0; i < health; i++) {
-        DrawTextureRec(heartsTexture, fullHeart, (Vector2){ x, 4 }, WHITE);
+    for (int i = 0; i < lives; i++) {
+        DrawTextureRec(GetTexture(heartsTexture), fullHeart, (Vector2){ x, 4 }, WHITE);
         x += 11;
     }
-    for (int i = 0; i < 3 - health; i++) {
-        DrawTextureRec(heartsTexture, emptyHeart, (Vector2){ x, 4 }, WHITE);
+    for (int i = 0; i < MAX_HEALTH - lives; i++) {
+        DrawTextureRec(GetTexture(heartsTexture), emptyHeart, (Vector2){ x, 4 }, WHITE);
         x += 11;
     }
 }
 
+void DrawHealth()
+{
+    DrawHearts(gameScreenWidth - 100, health);
+    if (versusMode) DrawHearts(60, opponentHealth);
+
+    // Collected key sits left of the hearts
+    if (hasKey) DrawTextureRec(GetTexture(mainTexture), powerupQuads[POWERUP_KEY], (Vector2){ gameScreenWidth - 118, 1 }, WHITE);
+}
+
+void DrawScoreLine()
+{
+    // Draw score at top right, player 2 next to its hearts in versus
+    Vector2 scorePosition = {gameScreenWidth - 60, 5};
+    if (versusMode) {
+        DrawFontText(gameFont, FrameFormat("P1: %d", score), scorePosition, 8, 1, WHITE);
+        DrawFontText(gameFont, FrameFormat("P2: %d", opponentScore), (Vector2){100, 5}, 8, 1, WHITE);
+    } else {
+        DrawFontText(gameFont, FrameFormat("Score: %d", score), scorePosition, 8, 1, WHITE);
+    }
+}
+
 void DrawServe()
 {
     DrawPaddle(&playerPaddle);
-    DrawBall(&ball);
+    if (versusMode) DrawPaddle(&opponentPaddle);
+    DrawBalls();
     DrawBricks();
+    DrawPowerups();
     DrawHealth();
-
-    // Draw score at top right
-    Vector2 scorePosition = {gameScreenWidth - 60, 5};
-    DrawTextEx(smallFont, TextFormat("Score: %d", score), scorePosition, 8, 1, WHITE);
+    DrawScoreLine();
 
     // Draw serve message
-    const char* msg = "Press Enter to serve!";
+    const char* msg = versusMode ? FrameFormat("Player %d to serve!", servingPlayer + 1) : "Press Enter to serve!";
     int textWidth = MeasureText(msg, 20);
     Vector2 position = {(gameScreenWidth - textWidth) / 2, gameScreenHeight / 2};
-    DrawTextEx(mediumFont, msg, position, 16, 1, WHITE);
+    DrawFontText(gameFont, msg, position, 16, 1, WHITE);
 }
 
 void DrawGameOver()
@@ -673,9 +1493,140 @@ void DrawGameOver()
     int y2 = gameScreenHeight / 2;
     int y3 = gameScreenHeight - gameScreenHeight / 4;
     const char* msg1 = "GAME OVER";
-    const char* msg2 = TextFormat("Final Score: %d", score);
-    const char* msg3 = "Press Enter!";
-    DrawTextEx(largeFont, msg1, (Vector2){centerX - MeasureText(msg1, 32)/2, y1}, 32, 1, WHITE);
-    DrawTextEx(mediumFont, msg2,(Vector2){centerX - MeasureText(msg2, 20)/2, y2}, 16, 1, WHITE);
-    DrawTextEx(mediumFont, msg3,(Vector2){centerX - MeasureText(msg3, 20)/2, y3}, 16, 1, WHITE);
+    const char* msg2 = FrameFormat("Final Score: %d", score);
+    const char* msg3 = versusMode ? "Press Enter for a rematch!" : "Press Enter!";
+    if (versusMode) {
+        msg1 = (health > 0) ? "PLAYER 1 WINS" : "PLAYER 2 WINS";
+        msg2 = FrameFormat("P1: %d  P2: %d", score, opponentScore);
+    }
+    DrawFontText(gameFont, msg1, (Vector2){centerX - MeasureText(msg1, 32)/2, y1}, 32, 1, WHITE);
+    DrawFontText(gameFont, msg2,(Vector2){centerX - MeasureText(msg2, 20)/2, y2}, 16, 1, WHITE);
+    DrawFontText(gameFont, msg3,(Vector2){centerX - MeasureText(msg3, 20)/2, y3}, 16, 1, WHITE);
+}
+
+void DrawVictory()
+{
+    DrawPaddle(&playerPaddle);
+    if (versusMode) DrawPaddle(&opponentPaddle);
+    DrawBalls();
+    DrawHealth();
+    DrawScoreLine();
+
+    int centerX = gameScreenWidth / 2;
+    const char *msg1 = FrameFormat("Level %d complete!", level);
+    const char *msg2 = versusMode ? FrameFormat("Player %d to serve!", servingPlayer + 1) : "Press Enter to serve!";
+    Vector2 size1 = MeasureFontText(gameFont, msg1, 32, 1);
+    Vector2 size2 = MeasureFontText(gameFont, msg2, 16, 1);
+    DrawFontText(gameFont, msg1, (Vector2){centerX - size1.x / 2, gameScreenHeight / 4}, 32, 1, WHITE);
+    DrawFontText(gameFont, msg2, (Vector2){centerX - size2.x / 2, gameScreenHeight / 2}, 16, 1, WHITE);
+}
+
+void DrawHighScores()
+{
+    const char *title = "HIGH SCORES";
+    Vector2 titleSize = MeasureFontText(gameFont, title, 32, 1);
+    DrawFontText(gameFont, title, (Vector2){(gameScreenWidth - titleSize.x) / 2, 16}, 32, 1, WHITE);
+
+    const HighScoreTable *table = GetHighScores();
+    float y = 60;
+    for (int i = 0; i < HIGHSCORE_COUNT; i++) {
+        Color color = (i < table->count) ? WHITE : GRAY;
+        DrawFontText(gameFont, FrameFormat("%2d.", i + 1), (Vector2){gameScreenWidth / 4, y}, 8, 1, color);
+        if (i < table->count) {
+            DrawFontText(gameFont, FrameFormat("%d", table->entries[i].score), (Vector2){gameScreenWidth / 4 + 40, y}, 8, 1, WHITE);
+            DrawFontText(gameFont, FrameFormat("Level %d", table->entries[i].level), (Vector2){gameScreenWidth / 2 + 40, y}, 8, 1, blueColor);
+        } else {
+            DrawFontText(gameFont, "---", (Vector2){gameScreenWidth / 4 + 40, y}, 8, 1, color);
+        }
+        y += 13;
+    }
+
+    const char *msg = "Press Enter to return to the main menu!";
+    Vector2 msgSize = MeasureFontText(gameFont, msg, 8, 1);
+    DrawFontText(gameFont, msg, (Vector2){(gameScreenWidth - msgSize.x) / 2, gameScreenHeight - 18}, 8, 1, WHITE);
+}
+
+void DrawRewind()
+{
+    const char *msg = FrameFormat("REWIND -%d / %d", rewindCursor, RewindFrameCount(&rewindBuffer));
+    Vector2 size = MeasureFontText(gameFont, msg, 8, 1);
+    DrawFontText(gameFont, msg, (Vector2){(gameScreenWidth - size.x) / 2, 5}, 8, 1, blueColor);
+
+    // Ball state, the usual suspect when chasing tunneling through bricks
+    const char *info = FrameFormat("balls %d  first %.1f,%.1f  v %.1f,%.1f  bricks %d/%d", balls.count, balls.x[0], balls.y[0],
+                                  balls.dx[0], balls.dy[0], CountLiveBricks(), brickCount);
+    size = MeasureFontText(gameFont, info, 8, 1);
+    DrawFontText(gameFont, info, (Vector2){(gameScreenWidth - size.x) / 2, gameScreenHeight - 12}, 8, 1, blueColor);
+}
+
+static void DrawArenaLine(const char *name, const Arena *arena, float y)
+{
+    const char *line = FrameFormat("%-9s %5.1f / %3d KB  peak %5.1f  %3d allocs  %d failed", name,
+                                   arena->used / 1024.0f, (int)(arena->capacity / 1024), arena->peak / 1024.0f,
+                                   arena->allocations, arena->failures);
+    DrawFontText(gameFont, line, (Vector2){ 5, y }, 8, 1, GREEN);
+}
+
+static void DrawResourceLines(float y)
+{
+    const ResourceTotals *totals = GetResourceTotals();
+    for (int c = 0; c < RESOURCE_CATEGORY_COUNT; c++) {
+        const char *line = FrameFormat("%-9s %3d assets  cpu %7.1f KB  gpu %7.1f KB", GetResourceCategoryName(c),
+                                       totals[c].count, totals[c].cpuBytes / 1024.0f, totals[c].gpuBytes / 1024.0f);
+        DrawFontText(gameFont, line, (Vector2){ 5, y + c * 10 }, 8, 1, GREEN);
+    }
+
+    const char *names[3];
+    int undrawn = GetUndrawnResources(names, 3);
+    const char *line = FrameFormat("never drawn: %d", undrawn);
+    for (int i = 0; i < undrawn && i < 3; i++) line = FrameFormat("%s %s", line, GetFileName(names[i]));
+    DrawFontText(gameFont, line, (Vector2){ 5, y + RESOURCE_CATEGORY_COUNT * 10 }, 8, 1, GREEN);
+}
+
+void DrawDebugOverlay()
+{
+    float y = gameScreenHeight - 90;
+    DrawResourceLines(y);
+    DrawArenaLine("permanent", &permanentArena, y + 50);
+    DrawArenaLine("level", &levelArena, y + 60);
+    DrawArenaLine("frame", &frameArena, y + 70);
+
+    JobStats jobs = GetJobStats();
+    DrawFontText(gameFont, FrameFormat("jobs      %d threads  %lld run  %lld stolen", jobs.threads, jobs.executed, jobs.stolen),
+                 (Vector2){ 5, y + 80 }, 8, 1, GREEN);
+}
+
+void DrawNetplayStatus()
+{
+    const NetplayStats *stats = GetNetplayStats();
+
+    const char *msg = NULL;
+    if (!stats->synced) msg = "WAITING FOR PEER...";
+    else if (stats->timedOut) msg = "CONNECTION LOST";
+
+    if (msg != NULL) {
+        Vector2 size = MeasureFontText(gameFont, msg, 16, 1);
+        DrawFontText(gameFont, msg, (Vector2){(gameScreenWidth - size.x) / 2, 50}, 16, 1, blueColor);
+    }
+
+    const char *info = FrameFormat("tick %d  confirmed %d  rollback %d (%.2f ms)  stalls %d",
+                                  stats->frame, stats->remoteFrame, stats->rollbackFrames, stats->rollbackMs, stats->stalls);
+    Vector2 size = MeasureFontText(gameFont, info, 8, 1);
+    DrawFontText(gameFont, info, (Vector2){(gameScreenWidth - size.x) / 2, gameScreenHeight - 12}, 8, 1, GRAY);
+}
+
+void DrawSpectatorStatus()
+{
+    const SpectatorStats *stats = GetSpectatorStats();
+
+    const char *msg;
+    if (GetSpectatorMode() == SPECTATOR_SERVER)
+        msg = FrameFormat("LIVE  %d watching  %d B/tick", stats->clients, stats->lastMessage);
+    else if (!stats->connected)
+        msg = "STREAM ENDED";
+    else
+        msg = "SPECTATING";
+
+    Vector2 size = MeasureFontText(gameFont, msg, 8, 1);
+    DrawFontText(gameFont, msg, (Vector2){gameScreenWidth - size.x - 5, 5}, 8, 1, GRAY);
 }
@@ -11,27 +11,87 @@
 #include <unistd.h>
 #include <math.h>
 #include <time.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "raylib.h"
 #include "raymath.h"
 
+#include "highscore.h"
+#include "voices.h"
+#include "audioevents.h"
+#include "arena.h"
+#include "jobs.h"
+#include "framepacing.h"
+#include "audiopack.h"
+#include "texpack.h"
+#include "sdffont.h"
+#include "resources.h"
+#include "levelpack.h"
+#include "rewind.h"
+#include "netplay.h"
+#include "spectator.h"
+
 /* HELPERS */
 #define MAX(a, b) ((a)>(b)? (a) : (b))
 #define MIN(a, b) ((a)<(b)? (a) : (b))
 
+/* INPUT */
+// Everything a paddle player can do in one tick, so the simulation never reads
+// the keyboard itself and can be replayed from recorded or remote inputs
+typedef unsigned char PaddleInput;
+#define INPUT_LEFT  0x01
+#define INPUT_RIGHT 0x02
+#define INPUT_SERVE 0x04
+
+PaddleInput ReadPaddleInput(void);
+
+/* MEMORY */
+// One block reserved at startup and split three ways: the frame arena is
+// reset at the end of every UpdateDrawFrame(), the level arena whenever a new
+// wall is installed, and the rest lives as long as the game
+#define PERMANENT_ARENA_SIZE (128 * 1024)
+#define LEVEL_ARENA_SIZE (32 * 1024)
+#define FRAME_ARENA_SIZE (16 * 1024)
+
+extern Arena permanentArena;
+extern Arena levelArena;
+extern Arena frameArena;
+
+bool InitArenas(void);
+void UnloadArenas(void);
+void DrawDebugOverlay(void);
+
+// Replaces TextFormat(), whose few rotating buffers get overwritten by a busy frame
+#define FrameFormat(...) ArenaFormat(&frameArena, __VA_ARGS__)
+
 /* GAME */
-void UpdateDrawFrame(RenderTexture2D target);
-void GameLogic(float deltaTime);
+/* RENDERING */
+// By default the scene is drawn into a gameScreenWidth x gameScreenHeight
+// render texture that is then scaled to the window. --native draws it
+// straight to the backbuffer instead, through a Camera2D with a whole-number
+// zoom, so there is no offscreen pass; the letterbox bars are whatever lies
+// outside the scissor rectangle.
+extern bool nativeResolution;
+
+void UpdateDrawFrame(RenderTexture2D target);  // target is unused with nativeResolution
+void GameLogic(const PaddleInput *inputs, float deltaTime);
+void SimulateTick(const PaddleInput *inputs, float deltaTime);
+void PlaySimSound(Sound sound, float x);
 void DrawFPSCustom(void);
 void DrawGame(void);
 void UpdateStartMenu(void);
 void DrawStartMenu(void);
+void UpdateHighScores(void);
+void DrawHighScores(void);
 
 typedef enum {
     STATE_START,
     STATE_PLAY,
     STATE_SERVE,
     STATE_GAME_OVER,
+    STATE_HIGH_SCORES,
+    STATE_VICTORY,
 } GameState;
 
 typedef struct {
@@ -53,31 +113,58 @@ typedef struct {
 
 void InitPaddleQuads(void);
 void InitPaddle(Paddle *p);
-void UpdatePaddle(Paddle *p, float dt);
+void UpdatePaddle(Paddle *p, PaddleInput input, float dt);
 void DrawPaddle(Paddle *p);
 
 
+/* BALLS */
+// Struct-of-arrays pool, so every collision pass is a straight loop over plain
+// float arrays. Order is not meaningful; removing a ball moves the last one into its slot.
+#define MAX_BALLS 2048
+#define BALL_SIZE 8
+#define BALL_SKINS 7
+
 typedef struct {
-    float x, y;
-    float dx, dy;
-    int width, height;
-    int skin;  // 0 to 6
-} Ball;
+    int count;
+    float x[MAX_BALLS];
+    float y[MAX_BALLS];
+    float dx[MAX_BALLS];
+    float dy[MAX_BALLS];
+    unsigned char skin[MAX_BALLS];   // 0 to 6
+    unsigned char owner[MAX_BALLS];  // Player who touched it last, scores the bricks it breaks
+} BallPool;
+
+extern BallPool balls;
 
 void InitBallQuads(void);
-void InitBall(Ball *b);
-void UpdateBall(Ball *b, float dt);
-void DrawBall(Ball *b);
+void ResetBalls(void);
+int SpawnBall(float x, float y, float dx, float dy, int owner);  // -1 when the pool is full
+void SplitBalls(int copies);
+void RemoveBall(int i);
+void UpdateBalls(float dt);
+void DrawBalls(void);
 
 #define BRICK_WIDTH 32
 #define BRICK_HEIGHT 16
 #define MAX_BRICKS 100
 #define BRICK_QUAD_COUNT 21
+#define BRICK_COLORS 5  // Colors 1 to 5 by tiers 0 to 3 pick one of the first 20 quads
+#define BRICK_TIERS 4
+
+// Bricks sit on a 32x16 lattice, 13 columns from x = 8; the grid maps each
+// cell to the brick in it so a ball only tests the cells it overlaps
+#define BRICK_GRID_X 8
+#define BRICK_GRID_COLS 13
+#define BRICK_GRID_ROWS 16
+
+// Which bricks are still in play is one bit per bricks[] slot; bricksLeft
+// counts the set bits so a cleared wall is a single compare
+#define BRICK_WORDS ((MAX_BRICKS + 63) / 64)
 
 typedef struct {
     float x, y;
     float width, height;
-    bool inPlay;
+    bool locked;  // Only breaks once the key has been collected
     int color;
     int tier;
     int spriteIndex;
@@ -85,17 +172,152 @@ typedef struct {
 
 void InitBrickQuads(void);
 void InitBricks(void);
+void AdvanceLevel(void);                   // Installs the wall prepared in the background
+void BuildBrickGrid(void);
+void ResetBrickLive(void);                 // Every brick in bricks[] in play
+bool IsBrickLive(int i);
+void KillBrick(int i);
+int NextLiveBrick(int from);               // Index of the first live brick at or after from, or -1
+int CountLiveBricks(void);                 // Popcount of the live set
+void LevelCleared(void);
+int FindBrick(float x, float y, float width, float height);  // Lowest index brick in play it overlaps, or -1
 void DrawBricks(void);
 
-void ServeState(float dt);
+/* POWERUPS */
+// Pickups live in a fixed pool threaded by a free list, so spawning never
+// allocates. Catching one only queues its effect; the queue is applied once
+// every collision pass of the tick is done, so new balls or a wider paddle
+// never change a loop that is still running.
+#define MAX_POWERUPS 32
+#define MAX_POWERUP_EFFECTS 16
+#define POWERUP_SIZE 16
+#define POWERUP_SPEED 40.0f
+#define POWERUP_DROP_CHANCE 12  // Percent per brick hit
+#define MULTIBALL_EXTRA_BALLS 2
+#define LOCKED_BRICK_POINTS 5000
+
+typedef enum {
+    POWERUP_GROW,       // Paddle one size up
+    POWERUP_MULTIBALL,  // Extra balls launched from the paddle
+    POWERUP_KEY,        // Unlocks locked bricks
+    POWERUP_TYPE_COUNT,
+} PowerupType;
+
+typedef struct {
+    float x, y;
+    PowerupType type;
+    bool active;
+    int next;  // Next free slot, only meaningful while inactive
+} Powerup;
+
+typedef struct {
+    Powerup items[MAX_POWERUPS];
+    int freeHead;
+} PowerupPool;
+
+typedef struct {
+    PowerupType items[MAX_POWERUP_EFFECTS];
+    int count;
+} EffectQueue;
+
+extern PowerupPool powerups;
+extern bool hasKey;
+
+void InitPowerupQuads(void);
+void ResetPowerups(void);
+int SpawnPowerup(PowerupType type, float x, float y);  // -1 when the pool is full
+void FreePowerup(int i);
+void DropPowerup(const Brick *brick);
+void UpdatePowerups(float dt);
+void QueueEffect(PowerupType type);
+void ApplyEffects(void);
+void DrawPowerups(void);
+
+void ServeState(const PaddleInput *inputs, float dt);
 void GameOverState(void);
+void VictoryState(const PaddleInput *inputs, float dt);
+void LoseBall(int player, float x);
 void DrawHealth(void);
+void DrawScoreLine(void);
+void DrawNetplayStatus(void);
+void DrawSpectatorStatus(void);
 void DrawServe(void);
 void DrawGameOver(void);
+void DrawVictory(void);
+
+#define MAX_HEALTH 3
 
 void InitGameState(void);
 
-void HandleBallPaddleCollision(Ball *ball, Paddle *paddle);
-void HandleBallBrickCollision(Ball *ball, Brick *brick);
+/* VERSUS */
+// Two paddles, player 1 at the bottom and player 2 at the top, bricks in between
+#define VERSUS_PADDLE_Y 20
+
+void StartVersusMatch(unsigned int seed);
+void VersusGameOverState(const PaddleInput *inputs);
+
+extern bool versusMode;
+extern bool isResimulating;
+extern int gameScreenHeight;
+
+/* SAVE STATE */
+#define SAVESTATE_MAGIC 0x4B524242u  // "BBRK"
+#define SAVESTATE_VERSION 7
+
+// Fixed-layout copy of everything the simulation reads or writes,
+// small enough to take every tick
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    GameState state;
+    bool versusMode;
+    Paddle playerPaddle;
+    Paddle opponentPaddle;
+    BallPool balls;
+    int brickCount;
+    Brick bricks[MAX_BRICKS];
+    uint64_t brickLive[BRICK_WORDS];
+    PowerupPool powerups;
+    bool hasKey;
+    int health;
+    int score;
+    int level;
+    int opponentHealth;
+    int opponentScore;
+    int servingPlayer;
+    unsigned int rngState;
+    unsigned int nextLevelSeed;
+} GameSnapshot;
+
+void SaveState(GameSnapshot *snapshot);
+bool LoadState(const GameSnapshot *snapshot);  // False if it does not fit this build or holds out-of-range values
+
+/* REWIND */
+#define REWIND_SECONDS 10
+#define REWIND_KEYFRAME_INTERVAL 60
+
+void UpdateRewind(void);
+void DrawRewind(void);
+
+/* TURBO */
+// Fast-forward for watching long runs: T cycles the speed through 1x, 8x and
+// TURBO_MAX, and --turbo <ticks> starts at any speed up to TURBO_MAX. Each
+// displayed frame runs that many ticks of play back to back and draws only
+// the last; their sounds reach the mixer in one flush, so repeats of a sound
+// merge into a single voice. Menus, rewind and the network modes always run
+// at normal speed.
+#define TURBO_MAX 64
+
+extern int turboTicks;  // Per displayed frame, 1 is normal speed
+
+void SeedRandom(unsigned int seed);
+int RandomValue(int min, int max);                      // From the simulation's own state
+unsigned int NextRandom(unsigned int *state);
+int RandomFrom(unsigned int *state, int min, int max);
+
+void CollideBallsWithPaddle(Paddle *paddle, int player);
+void HandleBallPaddleCollision(int ball, Paddle *paddle);
+void HandleBallBrickCollision(int ball, int brick);
 
 #endif // GAME_H
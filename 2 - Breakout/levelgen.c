@@ -0,0 +1,157 @@
+#include "levelgen.h"
+#include "jobs.h"
+
+static JobCounter builderJob = { 0 };
+static bool builderRequested = false;
+static LevelLayout requested;  // Only the key fields are used
+static LevelLayout built;
+
+static void LoadPackedBricks(LevelLayout *layout, const LevelRecord *record)
+{
+    // Centered on whole cells, an even width sits half a brick left of center rather than off the grid
+    int left = BRICK_GRID_X + (BRICK_GRID_COLS - record->cols) / 2 * BRICK_WIDTH;
+
+    for (int i = 0; i < record->brickCount && layout->count < MAX_BRICKS; i++) {
+        const LevelBrick *brick = &record->bricks[i];
+        if (brick->col >= record->cols || brick->row >= record->rows) continue;
+
+        layout->bricks[layout->count++] = (Brick){
+            .x = left + brick->col * BRICK_WIDTH,
+            .y = BRICK_HEIGHT + brick->row * BRICK_HEIGHT,
+            .width = BRICK_WIDTH,
+            .height = BRICK_HEIGHT,
+            .locked = (brick->flags & LEVELPACK_BRICK_LOCKED) != 0,
+            .color = brick->color,
+            .tier = brick->tier,
+            .spriteIndex = brick->tier * 5 + (brick->color - 1)
+        };
+    }
+}
+
+static void GenerateBricks(LevelLayout *layout, unsigned int *rng)
+{
+    int numRows = RandomFrom(rng, 3, 5);
+    int numCols = RandomFrom(rng, 7, 13);
+    if (numCols % 2 == 0) numCols++; // ensure columns odd
+
+    // Level-dependent color/tier richness
+    int highestTier = MIN(3, (int)floor(layout->level / 5.0f));
+    int highestColor = MIN(3, layout->level % 5 + 3);
+
+    // Versus centers the wall between both paddles
+    int top = layout->versus ? (gameScreenHeight - numRows * BRICK_HEIGHT) / 2 : BRICK_HEIGHT;
+
+    for (int y = 0; y < numRows; y++) {
+
+        bool skipPattern = RandomFrom(rng, 0, 1) == 1;
+        bool alternatePattern = RandomFrom(rng, 0, 1) == 1;
+
+        int alternateColor1 = RandomFrom(rng, 1, highestColor);
+        int alternateColor2 = RandomFrom(rng, 1, highestColor);
+        int alternateTier1 = RandomFrom(rng, 0, highestTier);
+        int alternateTier2 = RandomFrom(rng, 0, highestTier);
+
+        bool skipFlag = RandomFrom(rng, 0, 1) == 1;
+        bool alternateFlag = RandomFrom(rng, 0, 1) == 1;
+
+        int solidColor = RandomFrom(rng, 1, highestColor);
+        int solidTier = RandomFrom(rng, 0, highestTier);
+
+        for (int x = 0; x < numCols; x++) {
+            if (layout->count >= MAX_BRICKS) break;
+
+            if (skipPattern && skipFlag) {
+                skipFlag = !skipFlag;
+                continue;
+            } else {
+                skipFlag = !skipFlag;
+            }
+
+            float bx = x * BRICK_WIDTH + 8 + (13 - numCols) * 16;
+            float by = top + y * BRICK_HEIGHT;
+
+            int color, tier;
+            if (alternatePattern) {
+                if (alternateFlag) {
+                    color = alternateColor1;
+                    tier = alternateTier1;
+                } else {
+                    color = alternateColor2;
+                    tier = alternateTier2;
+                }
+                alternateFlag = !alternateFlag;
+            } else {
+                color = solidColor;
+                tier = solidTier;
+            }
+
+            int spriteIndex = tier * 5 + (color - 1); // 5 colors (columns) × 4 tiers (rows) = 20 sprites
+
+            layout->bricks[layout->count++] = (Brick){
+                .x = bx,
+                .y = by,
+                .width = BRICK_WIDTH,
+                .height = BRICK_HEIGHT,
+                .color = color,
+                .tier = tier,
+                .spriteIndex = spriteIndex
+            };
+            TraceLog(LOG_DEBUG, "Brick %d → color=%d, tier=%d, spriteIndex=%d",
+                     layout->count, color, tier, spriteIndex);
+        }
+    }
+
+    // Some single player levels lock one brick, a key pickup opens it
+    if (!layout->versus && layout->count > 0 && RandomFrom(rng, 1, 3) == 1)
+        layout->bricks[RandomFrom(rng, 0, layout->count - 1)].locked = true;
+}
+
+void BuildLevel(LevelLayout *layout, int level, bool versus, unsigned int seed)
+{
+    layout->level = level;
+    layout->versus = versus;
+    layout->seed = seed;
+    layout->count = 0;
+
+    // Packed levels play first, then the generator takes over; versus always generates
+    const LevelRecord *record = versus ? NULL : GetPackedLevel(level - 1);
+    if (record != NULL) {
+        LoadPackedBricks(layout, record);
+    } else {
+        unsigned int rng = seed ? seed : 1;
+        GenerateBricks(layout, &rng);
+    }
+}
+
+static bool SameLevel(const LevelLayout *layout, int level, bool versus, unsigned int seed)
+{
+    return layout->level == level && layout->versus == versus && layout->seed == seed;
+}
+
+static void BuildRequestedLevel(void *data, int begin, int end)
+{
+    (void)data; (void)begin; (void)end;
+    BuildLevel(&built, requested.level, requested.versus, requested.seed);
+}
+
+// Main thread only; the job reads requested and writes built, and neither is touched until it is done
+void RequestLevel(int level, bool versus, unsigned int seed)
+{
+    if (builderRequested && SameLevel(&requested, level, versus, seed)) return;
+
+    WaitForJobs(&builderJob);
+    requested.level = level;
+    requested.versus = versus;
+    requested.seed = seed;
+    builderRequested = true;
+    RunJob(BuildRequestedLevel, NULL, &builderJob);
+}
+
+void TakeLevel(LevelLayout *layout, int level, bool versus, unsigned int seed)
+{
+    WaitForJobs(&builderJob);
+
+    // Rolled back, loaded or never requested: the seed still gives the same wall
+    if (builderRequested && SameLevel(&built, level, versus, seed)) *layout = built;
+    else BuildLevel(layout, level, versus, seed);
+}
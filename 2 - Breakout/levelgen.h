@@ -0,0 +1,26 @@
+#ifndef LEVELGEN_H
+#define LEVELGEN_H
+
+#include "game.h"
+
+/* LEVEL GENERATION */
+// A wall is a pure function of (level, versus, seed): packed levels come
+// from the level pack, the rest from the generator with its own RNG state.
+// That lets the next wall be built as a job (see jobs.h) while the current
+// one is played, and a rollback or loaded state simply rebuilds it from the
+// seed it saved if the prepared one does not match.
+
+typedef struct {
+    int level;
+    bool versus;
+    unsigned int seed;
+    int count;
+    Brick bricks[MAX_BRICKS];
+} LevelLayout;
+
+void BuildLevel(LevelLayout *layout, int level, bool versus, unsigned int seed);  // Any thread
+
+void RequestLevel(int level, bool versus, unsigned int seed);             // Starts building in the background
+void TakeLevel(LevelLayout *layout, int level, bool versus, unsigned int seed);  // Requested copy, or built now if it does not match
+
+#endif // LEVELGEN_H
@@ -0,0 +1,136 @@
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L  // mmap()
+#endif
+
+#include "levelpack.h"
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+static const unsigned char *packData = NULL;
+static size_t packSize = 0;
+static const uint32_t *offsets = NULL;
+static const unsigned char *records = NULL;
+static uint32_t levelCount = 0;
+static uint32_t recordsSize = 0;
+
+static const unsigned char *MapFile(const char *fileName, size_t *size)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER length;
+    const unsigned char *data = NULL;
+    if (GetFileSizeEx(file, &length) && length.QuadPart > 0) {
+        // The view keeps the mapping alive, both handles can go right away
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping != NULL) {
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+        *size = (size_t)length.QuadPart;
+    }
+    CloseHandle(file);
+    return data;
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat info;
+    void *data = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        *size = (size_t)info.st_size;
+    }
+    close(fd);
+    return (data == MAP_FAILED) ? NULL : data;
+#endif
+}
+
+static void UnmapFile(const unsigned char *data, size_t size)
+{
+#if defined(_WIN32)
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap((void *)data, size);
+#endif
+}
+
+bool OpenLevelPack(const char *fileName)
+{
+    CloseLevelPack();
+
+    size_t size = 0;
+    const unsigned char *data = MapFile(fileName, &size);
+    if (data == NULL) return false;
+
+    // Only the header is checked here, each record is checked when it is asked for
+    LevelPackHeader header;
+    if (size < sizeof(header)) goto invalid;
+    memcpy(&header, data, sizeof(header));
+
+    size_t tableEnd = sizeof(header) + (size_t)header.count * sizeof(uint32_t);
+    if (header.magic != LEVELPACK_MAGIC || header.version != LEVELPACK_VERSION ||
+        tableEnd > size || size - tableEnd != header.dataSize) goto invalid;
+
+    packData = data;
+    packSize = size;
+    offsets = (const uint32_t *)(data + sizeof(header));
+    records = data + tableEnd;
+    levelCount = header.count;
+    recordsSize = header.dataSize;
+    return true;
+
+invalid:
+    UnmapFile(data, size);
+    return false;
+}
+
+void CloseLevelPack(void)
+{
+    if (packData != NULL) UnmapFile(packData, packSize);
+    packData = NULL;
+    packSize = 0;
+    offsets = NULL;
+    records = NULL;
+    levelCount = 0;
+    recordsSize = 0;
+}
+
+int GetLevelPackCount(void)
+{
+    return (int)levelCount;
+}
+
+const LevelRecord *GetPackedLevel(int index)
+{
+    if (index < 0 || (uint32_t)index >= levelCount) return NULL;
+
+    uint32_t offset = offsets[index];
+    // Records hold a uint16_t, the cooker keeps them 2-byte aligned
+    if (offset % sizeof(uint16_t) != 0 || (uint64_t)offset + sizeof(LevelRecord) > recordsSize) return NULL;
+
+    const LevelRecord *level = (const LevelRecord *)(records + offset);
+    if (level->brickCount > LEVELPACK_MAX_BRICKS || level->cols == 0 || level->cols > LEVELPACK_MAX_COLS ||
+        level->rows == 0 || level->rows > LEVELPACK_MAX_ROWS ||
+        (uint64_t)offset + sizeof(LevelRecord) + level->brickCount * sizeof(LevelBrick) > recordsSize) return NULL;
+
+    // Color and tier pick the brick's sprite, so one out of range would draw from past the quad table
+    for (int i = 0; i < level->brickCount; i++) {
+        const LevelBrick *brick = &level->bricks[i];
+        if (brick->color < 1 || brick->color > LEVELPACK_MAX_COLOR || brick->tier > LEVELPACK_MAX_TIER) return NULL;
+    }
+
+    return level;
+}
@@ -0,0 +1,56 @@
+#ifndef LEVELPACK_H
+#define LEVELPACK_H
+
+#include <stdint.h>
+#include "stdbool.h"
+
+/* LEVEL PACK */
+// Handcrafted levels written as text in res/levels/*.txt and compiled by
+// tools/levelcook into one binary pack. The pack is memory mapped and used in
+// place: opening costs the same for three levels or three thousand, and a
+// level is found through the offset table without scanning the ones before it.
+// Kept free of raylib.h so the Win32 mapping API can be included here.
+// Layout: LevelPackHeader, count uint32 offsets, then the level records.
+
+#define LEVELPACK_MAGIC 0x4C564C42u  // "BLVL"
+#define LEVELPACK_VERSION 1
+#define LEVELPACK_NAME_SIZE 32
+
+// Same lattice the procedural generator uses: 13 columns of 32x16 bricks
+#define LEVELPACK_MAX_COLS 13
+#define LEVELPACK_MAX_ROWS 10
+#define LEVELPACK_MAX_BRICKS 100
+
+#define LEVELPACK_MAX_COLOR 5   // Colors run 1..5, tiers 0..3, as in the brick sprite sheet
+#define LEVELPACK_MAX_TIER 3
+
+#define LEVELPACK_BRICK_LOCKED 0x01
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t dataSize;  // Bytes of level records after the offset table
+} LevelPackHeader;
+
+typedef struct {
+    uint8_t col, row;  // Cell within the level's cols x rows grid
+    uint8_t color;     // 1-5
+    uint8_t tier;      // 0-3
+    uint8_t spriteIndex;  // Written by the cooker, the game derives it from color and tier
+    uint8_t flags;
+} LevelBrick;
+
+typedef struct {
+    char name[LEVELPACK_NAME_SIZE];
+    uint16_t brickCount;
+    uint8_t cols, rows;  // Grid size, the game centers it on whole cells like a generated wall
+    LevelBrick bricks[];
+} LevelRecord;
+
+bool OpenLevelPack(const char *fileName);
+void CloseLevelPack(void);
+int GetLevelPackCount(void);
+const LevelRecord *GetPackedLevel(int index);  // Points into the mapping, NULL if out of range or damaged
+
+#endif // LEVELPACK_H
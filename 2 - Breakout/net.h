@@ -0,0 +1,37 @@
+#ifndef NET_H
+#define NET_H
+
+#include <stdint.h>
+#include "stdbool.h"
+
+/* NETWORK */
+// Thin wrapper over BSD sockets / Winsock. Kept free of <winsock2.h> types,
+// which cannot be included next to raylib.h.
+
+typedef intptr_t NetSocket;
+#define NET_INVALID_SOCKET ((NetSocket)-1)
+
+typedef struct {
+    uint32_t host;  // IPv4, network byte order
+    uint16_t port;  // network byte order
+} NetAddress;
+
+bool InitNet(void);
+void CloseNet(void);
+
+bool NetResolve(const char *host, int port, NetAddress *address);
+bool NetAddressEqual(NetAddress a, NetAddress b);
+
+NetSocket NetOpenUdp(int port);  // Non-blocking, bound to all interfaces
+int NetSendTo(NetSocket sock, NetAddress to, const void *data, int size);
+int NetReceiveFrom(NetSocket sock, NetAddress *from, void *data, int size);  // -1 if nothing pending
+
+NetSocket NetListenTcp(int port);                     // Non-blocking listening socket
+NetSocket NetAccept(NetSocket listener);              // NET_INVALID_SOCKET if nobody is waiting
+NetSocket NetConnectTcp(NetAddress to);               // Blocks until connected, then non-blocking
+int NetSend(NetSocket sock, const void *data, int size);     // Bytes sent, 0 if it would block, -1 on error
+int NetReceive(NetSocket sock, void *data, int size);        // Bytes read, 0 if nothing pending, -1 on close or error
+
+void NetCloseSocket(NetSocket sock);
+
+#endif // NET_H
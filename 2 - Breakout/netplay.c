@@ -0,0 +1,394 @@
+#include "netplay.h"
+#include "game.h"
+#include "net.h"
+
+// Packet layout, little-endian:
+//   [0] type  [1] input count  [2] sender frame advantage (signed)  [3] unused
+//   [4..7] first input frame (match seed for SYNC)
+//   [8..11] last remote frame received in order
+//   [12..15] sender's current frame
+//   [16..] one PaddleInput per frame
+#define NETPLAY_MSG_SYNC     1
+#define NETPLAY_MSG_SYNC_ACK 2
+#define NETPLAY_MSG_INPUT    3
+#define NETPLAY_HEADER_SIZE  16
+#define NETPLAY_MAX_PACKET   (NETPLAY_HEADER_SIZE + NETPLAY_MAX_SEND_INPUTS)
+
+#define NETPLAY_STATE_SLOTS (NETPLAY_MAX_ROLLBACK + 2)
+#define NETPLAY_DELAY_QUEUE 128
+#define NETPLAY_SYNC_INTERVAL 0.2
+#define NETPLAY_TIMESYNC_INTERVAL 10  // Ticks between time sync corrections
+
+#define INPUT_INDEX(frame) ((frame) & (NETPLAY_INPUT_WINDOW - 1))
+
+typedef struct {
+    double due;
+    int size;
+    unsigned char data[NETPLAY_MAX_PACKET];
+} DelayedPacket;
+
+static struct {
+    bool active;
+    NetplayConfig config;
+    NetSocket sock;
+    NetAddress peer;
+    unsigned int seed;
+    double lastSyncSent;
+    double lastReceived;
+
+    PaddleInput localInput[NETPLAY_INPUT_WINDOW];
+    PaddleInput remoteInput[NETPLAY_INPUT_WINDOW];
+    PaddleInput usedRemote[NETPLAY_INPUT_WINDOW];  // What the simulation was given, confirmed or predicted
+    GameSnapshot states[NETPLAY_STATE_SLOTS];      // State at the start of each recent tick
+
+    int frame;
+    int remoteLast;
+    int localAcked;
+    int peerFrame;
+    int peerAdvantage;
+    int rollbackFrom;
+    int sinceTimeSync;
+    float accumulator;
+
+    DelayedPacket delayQueue[NETPLAY_DELAY_QUEUE];
+    int delayHead;
+    int delayCount;
+
+    NetplayStats stats;
+} net = { 0 };
+
+static void PutU32(unsigned char *p, uint32_t v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static uint32_t GetU32(const unsigned char *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool ParseNetplayArgs(int argc, char *argv[], NetplayConfig *config)
+{
+    bool found = false;
+
+    memset(config, 0, sizeof(*config));
+    config->inputDelay = 2;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--netplay") == 0 && i + 4 < argc) {
+            config->player = atoi(argv[i + 1]) - 1;
+            config->localPort = atoi(argv[i + 2]);
+            snprintf(config->peerHost, sizeof(config->peerHost), "%s", argv[i + 3]);
+            config->peerPort = atoi(argv[i + 4]);
+            found = true;
+            i += 4;
+        } else if (strcmp(argv[i], "--delay") == 0 && i + 1 < argc) {
+            config->inputDelay = MAX(0, MIN(atoi(argv[++i]), 8));
+        } else if (strcmp(argv[i], "--lag") == 0 && i + 1 < argc) {
+            config->lagMs = MAX(0, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--loss") == 0 && i + 1 < argc) {
+            config->lossPercent = MAX(0, MIN(atoi(argv[++i]), 100));
+        }
+    }
+
+    return found && (config->player == 0 || config->player == 1);
+}
+
+static void ResetSession(void)
+{
+    memset(net.localInput, 0, sizeof(net.localInput));
+    memset(net.remoteInput, 0, sizeof(net.remoteInput));
+    memset(net.usedRemote, 0, sizeof(net.usedRemote));
+
+    // Ticks before the input delay runs out have empty input on both sides
+    net.frame = 0;
+    net.remoteLast = net.config.inputDelay - 1;
+    net.localAcked = net.config.inputDelay - 1;
+    net.peerFrame = 0;
+    net.peerAdvantage = 0;
+    net.rollbackFrom = -1;
+    net.sinceTimeSync = 0;
+    net.accumulator = 0.0f;
+    net.lastReceived = GetTime();
+}
+
+static void StartMatch(unsigned int seed)
+{
+    ResetSession();
+    StartVersusMatch(seed);
+    net.stats.synced = true;
+    TraceLog(LOG_INFO, "NETPLAY: Match started as player %d, seed %u", net.config.player + 1, seed);
+}
+
+bool InitNetplay(const NetplayConfig *config)
+{
+    net.config = *config;
+
+    if (!InitNet()) return false;
+
+    net.sock = NetOpenUdp(config->localPort);
+    if (net.sock == NET_INVALID_SOCKET) {
+        TraceLog(LOG_WARNING, "NETPLAY: Could not bind UDP port %d", config->localPort);
+        CloseNet();
+        return false;
+    }
+    if (!NetResolve(config->peerHost, config->peerPort, &net.peer)) {
+        TraceLog(LOG_WARNING, "NETPLAY: Could not resolve peer %s", config->peerHost);
+        NetCloseSocket(net.sock);
+        CloseNet();
+        return false;
+    }
+
+    net.seed = (unsigned int)time(NULL) ^ (unsigned int)(GetTime() * 1000000.0);
+    srand(net.seed);  // only drives simulated packet loss
+    net.lastSyncSent = -NETPLAY_SYNC_INTERVAL;
+    net.delayHead = 0;
+    net.delayCount = 0;
+    memset(&net.stats, 0, sizeof(net.stats));
+    ResetSession();
+
+    versusMode = true;
+    net.active = true;
+
+    TraceLog(LOG_INFO, "NETPLAY: Player %d on port %d, peer %s:%d, delay %d, lag %d ms, loss %d%%",
+             config->player + 1, config->localPort, config->peerHost, config->peerPort,
+             config->inputDelay, config->lagMs, config->lossPercent);
+    return true;
+}
+
+void CloseNetplay(void)
+{
+    if (!net.active) return;
+
+    NetCloseSocket(net.sock);
+    CloseNet();
+    net.active = false;
+}
+
+bool IsNetplayActive(void)
+{
+    return net.active;
+}
+
+const NetplayStats *GetNetplayStats(void)
+{
+    net.stats.frame = net.frame;
+    net.stats.remoteFrame = net.remoteLast;
+    return &net.stats;
+}
+
+// Outgoing packets go through the simulated lossy, laggy link when configured
+static void SendPacket(const unsigned char *data, int size)
+{
+    if (net.config.lossPercent > 0 && rand() % 100 < net.config.lossPercent) return;
+
+    if (net.config.lagMs == 0) {
+        NetSendTo(net.sock, net.peer, data, size);
+        return;
+    }
+    if (net.delayCount == NETPLAY_DELAY_QUEUE) return;
+
+    DelayedPacket *packet = &net.delayQueue[(net.delayHead + net.delayCount) % NETPLAY_DELAY_QUEUE];
+    packet->due = GetTime() + net.config.lagMs / 1000.0;
+    packet->size = size;
+    memcpy(packet->data, data, size);
+    net.delayCount++;
+}
+
+static void FlushDelayedPackets(void)
+{
+    double now = GetTime();
+    while (net.delayCount > 0 && net.delayQueue[net.delayHead].due <= now) {
+        DelayedPacket *packet = &net.delayQueue[net.delayHead];
+        NetSendTo(net.sock, net.peer, packet->data, packet->size);
+        net.delayHead = (net.delayHead + 1) % NETPLAY_DELAY_QUEUE;
+        net.delayCount--;
+    }
+}
+
+static void SendNetMessage(int type, uint32_t first, const PaddleInput *inputs, int count)
+{
+    unsigned char packet[NETPLAY_MAX_PACKET] = { 0 };
+
+    packet[0] = (unsigned char)type;
+    packet[1] = (unsigned char)count;
+    packet[2] = (unsigned char)(signed char)MAX(-128, MIN(net.frame - net.peerFrame, 127));
+    PutU32(packet + 4, first);
+    PutU32(packet + 8, (uint32_t)net.remoteLast);
+    PutU32(packet + 12, (uint32_t)net.frame);
+    for (int i = 0; i < count; i++) packet[NETPLAY_HEADER_SIZE + i] = inputs[i];
+
+    SendPacket(packet, NETPLAY_HEADER_SIZE + count);
+}
+
+static void SendInputs(void)
+{
+    // Everything the peer has not acknowledged yet, oldest first
+    int first = net.localAcked + 1;
+    int last = net.frame - 1 + net.config.inputDelay;
+    int count = MAX(0, MIN(last - first + 1, NETPLAY_MAX_SEND_INPUTS));
+
+    PaddleInput inputs[NETPLAY_MAX_SEND_INPUTS];
+    for (int i = 0; i < count; i++) inputs[i] = net.localInput[INPUT_INDEX(first + i)];
+
+    SendNetMessage(NETPLAY_MSG_INPUT, (uint32_t)first, inputs, count);
+}
+
+static void ReceiveInputs(const unsigned char *packet, int size)
+{
+    int count = packet[1];
+    int first = (int)GetU32(packet + 4);
+    if (size < NETPLAY_HEADER_SIZE + count) return;
+
+    net.localAcked = MAX(net.localAcked, (int)GetU32(packet + 8));
+    net.peerFrame = MAX(net.peerFrame, (int)GetU32(packet + 12));
+    net.peerAdvantage = (signed char)packet[2];
+
+    for (int i = 0; i < count; i++) {
+        int f = first + i;
+        if (f <= net.remoteLast) continue;
+        if (f != net.remoteLast + 1 || f >= net.frame + NETPLAY_INPUT_WINDOW - NETPLAY_MAX_ROLLBACK) break;
+
+        PaddleInput input = packet[NETPLAY_HEADER_SIZE + i];
+        net.remoteInput[INPUT_INDEX(f)] = input;
+        net.remoteLast = f;
+
+        // Already simulated with a guess that turned out wrong
+        if (f < net.frame && net.usedRemote[INPUT_INDEX(f)] != input) {
+            if (net.rollbackFrom < 0 || f < net.rollbackFrom) net.rollbackFrom = f;
+        }
+    }
+}
+
+static void ReceivePackets(void)
+{
+    unsigned char packet[NETPLAY_MAX_PACKET];
+    NetAddress from;
+    int size;
+
+    while ((size = NetReceiveFrom(net.sock, &from, packet, sizeof(packet))) >= 0) {
+        if (!NetAddressEqual(from, net.peer) || size < NETPLAY_HEADER_SIZE) continue;
+        net.lastReceived = GetTime();
+
+        switch (packet[0]) {
+            case NETPLAY_MSG_SYNC:
+                if (net.config.player == 1) {
+                    if (!net.stats.synced) StartMatch(GetU32(packet + 4));
+                    SendNetMessage(NETPLAY_MSG_SYNC_ACK, net.seed, NULL, 0);
+                }
+                break;
+            case NETPLAY_MSG_SYNC_ACK:
+                if (net.config.player == 0 && !net.stats.synced) StartMatch(net.seed);
+                break;
+            case NETPLAY_MSG_INPUT:
+                // Input from the guest also means our SYNC got through, even if its ACK did not
+                if (net.config.player == 0 && !net.stats.synced) StartMatch(net.seed);
+                if (net.stats.synced) ReceiveInputs(packet, size);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static void StepFrame(int frame)
+{
+    int local = net.config.player;
+    PaddleInput remote;
+
+    if (frame <= net.remoteLast) {
+        remote = net.remoteInput[INPUT_INDEX(frame)];
+    } else {
+        // Predict the peer keeps holding the same direction; presses are one-off events
+        remote = (net.remoteLast >= 0) ? net.remoteInput[INPUT_INDEX(net.remoteLast)] & ~INPUT_SERVE : 0;
+    }
+    net.usedRemote[INPUT_INDEX(frame)] = remote;
+
+    PaddleInput inputs[2];
+    inputs[local] = net.localInput[INPUT_INDEX(frame)];
+    inputs[1 - local] = remote;
+    SimulateTick(inputs, 1.0f / NETPLAY_TICK_RATE);
+}
+
+static void Rollback(void)
+{
+    double start = GetTime();
+    int from = net.rollbackFrom;
+
+    LoadState(&net.states[from % NETPLAY_STATE_SLOTS]);
+    isResimulating = true;
+    for (int f = from; f < net.frame; f++) {
+        if (f > from) SaveState(&net.states[f % NETPLAY_STATE_SLOTS]);
+        StepFrame(f);
+    }
+    isResimulating = false;
+
+    net.rollbackFrom = -1;
+    net.stats.rollbackFrames = net.frame - from;
+    net.stats.rollbackMs = (float)((GetTime() - start) * 1000.0);
+}
+
+static bool AdvanceFrame(PaddleInput input)
+{
+    // Too far ahead of what we know about the peer, wait for it
+    if (net.frame - net.remoteLast > NETPLAY_MAX_ROLLBACK) {
+        net.stats.stalls++;
+        return false;
+    }
+
+    // Time sync: both sides report how far ahead they think they are, the one
+    // further ahead gives up a tick now and then so neither keeps rolling back
+    int advantage = net.frame - net.peerFrame;
+    if (net.sinceTimeSync >= NETPLAY_TIMESYNC_INTERVAL && (advantage - net.peerAdvantage) / 2 >= 1) {
+        net.sinceTimeSync = 0;
+        net.stats.stalls++;
+        return false;
+    }
+    net.sinceTimeSync++;
+
+    net.localInput[INPUT_INDEX(net.frame + net.config.inputDelay)] = input;
+    SaveState(&net.states[net.frame % NETPLAY_STATE_SLOTS]);
+    StepFrame(net.frame);
+    net.frame++;
+    return true;
+}
+
+void UpdateNetplay(float deltaTime)
+{
+    if (!net.active) return;
+
+    FlushDelayedPackets();
+    ReceivePackets();
+
+    if (!net.stats.synced) {
+        // Player 1 picks the seed and keeps offering it until the peer answers
+        if (net.config.player == 0 && GetTime() - net.lastSyncSent >= NETPLAY_SYNC_INTERVAL) {
+            SendNetMessage(NETPLAY_MSG_SYNC, net.seed, NULL, 0);
+            net.lastSyncSent = GetTime();
+        }
+        return;
+    }
+
+    net.stats.timedOut = GetTime() - net.lastReceived > NETPLAY_TIMEOUT;
+
+    if (net.rollbackFrom >= 0) Rollback();
+
+    const float tick = 1.0f / NETPLAY_TICK_RATE;
+    net.accumulator = MIN(net.accumulator + deltaTime, 4 * tick);
+
+    // Read once per frame: a key press counts on the first tick, not on every catch-up tick
+    PaddleInput input = ReadPaddleInput();
+    while (net.accumulator >= tick) {
+        net.accumulator -= tick;
+        if (!AdvanceFrame(input)) {
+            net.accumulator = 0.0f;
+            break;
+        }
+        input &= ~INPUT_SERVE;
+    }
+
+    SendInputs();
+}
@@ -0,0 +1,45 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+#include "stdbool.h"
+
+/* NETPLAY */
+// Rollback netcode for versus mode: local input is applied immediately, remote
+// input is predicted, and when the real remote input arrives and differs the
+// match is restored from a saved tick and re-simulated up to the present.
+
+#define NETPLAY_TICK_RATE 60
+#define NETPLAY_MAX_ROLLBACK 16     // Ticks we may run ahead of confirmed remote input
+#define NETPLAY_INPUT_WINDOW 128    // Input history ring, power of two
+#define NETPLAY_MAX_SEND_INPUTS 64  // Unacknowledged inputs repeated in each packet
+#define NETPLAY_TIMEOUT 5.0         // Seconds without packets before the peer is considered gone
+
+typedef struct {
+    int player;          // 0 = bottom paddle, picks the match seed; 1 = top paddle
+    int localPort;
+    char peerHost[64];
+    int peerPort;
+    int inputDelay;      // Ticks between reading local input and applying it
+    int lagMs;           // Simulated latency added to outgoing packets
+    int lossPercent;     // Simulated loss of outgoing packets
+} NetplayConfig;
+
+typedef struct {
+    bool synced;
+    bool timedOut;
+    int frame;           // Next tick to simulate
+    int remoteFrame;     // Last tick with confirmed remote input
+    int rollbackFrames;  // Ticks re-simulated by the last rollback
+    float rollbackMs;    // Time spent in the last rollback
+    int stalls;          // Ticks skipped waiting for the peer
+} NetplayStats;
+
+// --netplay <1|2> <localPort> <peerHost> <peerPort> [--delay ticks] [--lag ms] [--loss percent]
+bool ParseNetplayArgs(int argc, char *argv[], NetplayConfig *config);
+bool InitNetplay(const NetplayConfig *config);
+void CloseNetplay(void);
+bool IsNetplayActive(void);
+void UpdateNetplay(float deltaTime);
+const NetplayStats *GetNetplayStats(void);
+
+#endif // NETPLAY_H
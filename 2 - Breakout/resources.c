@@ -0,0 +1,327 @@
+#include "resources.h"
+#include "texpack.h"
+#include "sdffont.h"
+#include "jobs.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    char path[RESOURCES_PATH_SIZE];
+    ResourceCategory category;
+    Texture2D texture;
+    Font font;
+    size_t cpuBytes;
+    size_t gpuBytes;
+    double loadSeconds;
+    int references;
+    uint8_t generation;
+    bool loaded;
+    bool owned;  // Loaded and unloaded here; sounds and music are only tracked
+    bool drawn;
+} ResourceSlot;
+
+static ResourceSlot slots[RESOURCES_MAX];
+static ResourceTotals totals[RESOURCE_CATEGORY_COUNT];
+
+static const char *categoryNames[RESOURCE_CATEGORY_COUNT] = { "textures", "fonts", "sounds", "music" };
+
+static size_t TextureBytes(Texture2D texture)
+{
+    size_t bytes = 0;
+    int width = texture.width;
+    int height = texture.height;
+    for (int level = 0; level < texture.mipmaps; level++) {
+        bytes += (size_t)GetPixelDataSize(width, height, texture.format);
+        width = (width > 1) ? width / 2 : 1;
+        height = (height > 1) ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+// The atlas lives on the GPU; glyph metrics and the per-glyph images raylib keeps stay on the CPU
+static void FontBytes(Font font, size_t *cpuBytes, size_t *gpuBytes)
+{
+    *gpuBytes = TextureBytes(font.texture);
+    *cpuBytes = (size_t)font.glyphCount * (sizeof(GlyphInfo) + sizeof(Rectangle));
+    for (int i = 0; font.glyphs != NULL && i < font.glyphCount; i++) {
+        Image image = font.glyphs[i].image;
+        if (image.data != NULL) *cpuBytes += (size_t)GetPixelDataSize(image.width, image.height, image.format);
+    }
+}
+
+static uint16_t MakeHandle(int slot)
+{
+    return (uint16_t)((slots[slot].generation << 8) | (slot + 1));
+}
+
+static ResourceSlot *FindSlot(uint16_t handle, ResourceCategory category)
+{
+    int slot = (handle & 0xFF) - 1;
+    if (slot < 0 || slot >= RESOURCES_MAX) return NULL;
+    if (!slots[slot].loaded || slots[slot].generation != (handle >> 8) || slots[slot].category != category) return NULL;
+    return &slots[slot];
+}
+
+// Existing slot for this asset with one more reference, or a free one to fill in
+static int ClaimSlot(const char *path, ResourceCategory category, bool *existing)
+{
+    int freeSlot = -1;
+    *existing = false;
+    for (int i = 0; i < RESOURCES_MAX; i++) {
+        if (!slots[i].loaded) {
+            if (freeSlot < 0) freeSlot = i;
+            continue;
+        }
+        if (slots[i].category == category && strcmp(slots[i].path, path) == 0) {
+            slots[i].references++;
+            *existing = true;
+            return i;
+        }
+    }
+
+    if (freeSlot < 0 || strlen(path) >= RESOURCES_PATH_SIZE) {
+        TraceLog(LOG_WARNING, "RESOURCES: [%s] No room for another %s entry", path, categoryNames[category]);
+        return -1;
+    }
+    return freeSlot;
+}
+
+static void FillSlot(int index, const char *path, ResourceCategory category, size_t cpuBytes, size_t gpuBytes,
+                     double loadSeconds, bool owned)
+{
+    ResourceSlot *slot = &slots[index];
+    snprintf(slot->path, sizeof(slot->path), "%s", path);
+    slot->category = category;
+    slot->cpuBytes = cpuBytes;
+    slot->gpuBytes = gpuBytes;
+    slot->loadSeconds = loadSeconds;
+    slot->references = 1;
+    slot->loaded = true;
+    slot->owned = owned;
+    slot->drawn = false;
+
+    totals[category].count++;
+    totals[category].cpuBytes += cpuBytes;
+    totals[category].gpuBytes += gpuBytes;
+    totals[category].loadSeconds += loadSeconds;
+    TraceLog(LOG_INFO, "RESOURCES: [%s] Loaded in %.2f ms", path, loadSeconds * 1000.0);
+}
+
+typedef struct {
+    const char *fileName;
+    Image image;
+    bool fromPack;
+    double seconds;
+} TextureDecode;
+
+static bool IsLoaded(const char *path, ResourceCategory category)
+{
+    for (int i = 0; i < RESOURCES_MAX; i++)
+        if (slots[i].loaded && slots[i].category == category && strcmp(slots[i].path, path) == 0) return true;
+    return false;
+}
+
+// decode is NULL to load here and now
+static TextureHandle AcquireDecodedTexture(const char *fileName, const TextureDecode *decode)
+{
+    bool existing;
+    int index = ClaimSlot(fileName, RESOURCE_TEXTURE, &existing);
+    if (index < 0) return INVALID_TEXTURE;
+
+    // A file that fails to load keeps its slot too, so it is not retried every reset
+    if (!existing) {
+        double start = GetTime();
+        if (decode == NULL) slots[index].texture = LoadPackedTexture(fileName);
+        else if (decode->image.data != NULL) slots[index].texture = LoadTextureFromImage(decode->image);
+        else slots[index].texture = (Texture2D){ 0 };
+        double seconds = GetTime() - start + ((decode != NULL) ? decode->seconds : 0.0);
+        FillSlot(index, fileName, RESOURCE_TEXTURE, 0, TextureBytes(slots[index].texture), seconds, true);
+    }
+    return MakeHandle(index);
+}
+
+TextureHandle AcquireTexture(const char *fileName)
+{
+    return AcquireDecodedTexture(fileName, NULL);
+}
+
+static void DecodeTextures(void *data, int begin, int end)
+{
+    TextureDecode *decodes = data;
+    for (int i = begin; i < end; i++) {
+        double start = GetTime();
+        decodes[i].image = LoadPackedImage(decodes[i].fileName, &decodes[i].fromPack);
+        decodes[i].seconds = GetTime() - start;
+    }
+}
+
+void AcquireTextures(TextureHandle *handles, const char **fileNames, int count)
+{
+    TextureDecode decodes[RESOURCES_MAX];
+    int decodeCount = 0;
+    int found[RESOURCES_MAX];  // Decode index per file, or -1 if it is loaded already
+
+    // A batch longer than RESOURCES_MAX cannot all fit; the extra names just load one by one
+    for (int i = 0; i < count && i < RESOURCES_MAX; i++) {
+        found[i] = -1;
+        if (IsLoaded(fileNames[i], RESOURCE_TEXTURE)) continue;
+        for (int j = 0; j < decodeCount && found[i] < 0; j++)
+            if (strcmp(decodes[j].fileName, fileNames[i]) == 0) found[i] = j;
+        if (found[i] < 0) {
+            decodes[decodeCount] = (TextureDecode){ .fileName = fileNames[i] };
+            found[i] = decodeCount++;
+        }
+    }
+
+    JobCounter decoded = { 0 };
+    ParallelFor(DecodeTextures, decodes, decodeCount, 1, &decoded);
+    WaitForJobs(&decoded);
+
+    // Uploads in the order given, the same as loading them one by one
+    for (int i = 0; i < count; i++)
+        handles[i] = AcquireDecodedTexture(fileNames[i], (i < RESOURCES_MAX && found[i] >= 0) ? &decodes[found[i]] : NULL);
+
+    for (int i = 0; i < decodeCount; i++)
+        if (!decodes[i].fromPack) UnloadImage(decodes[i].image);
+}
+
+void ReleaseTexture(TextureHandle handle)
+{
+    ResourceSlot *slot = FindSlot(handle, RESOURCE_TEXTURE);
+    if (slot != NULL && slot->references > 0) slot->references--;
+}
+
+Texture2D GetTexture(TextureHandle handle)
+{
+    ResourceSlot *slot = FindSlot(handle, RESOURCE_TEXTURE);
+    if (slot == NULL) return (Texture2D){ 0 };
+
+    slot->drawn = true;
+    return slot->texture;
+}
+
+FontHandle AcquireFont(const char *fileName)
+{
+    bool existing;
+    int index = ClaimSlot(fileName, RESOURCE_FONT, &existing);
+    if (index < 0) return INVALID_FONT;
+
+    if (!existing) {
+        double start = GetTime();
+        Font font = LoadSdfFont(fileName);
+        size_t cpuBytes, gpuBytes;
+        FontBytes(font, &cpuBytes, &gpuBytes);
+        slots[index].font = font;
+        FillSlot(index, fileName, RESOURCE_FONT, cpuBytes, gpuBytes, GetTime() - start, true);
+    }
+    return MakeHandle(index);
+}
+
+void ReleaseFont(FontHandle handle)
+{
+    ResourceSlot *slot = FindSlot(handle, RESOURCE_FONT);
+    if (slot != NULL && slot->references > 0) slot->references--;
+}
+
+void DrawFontText(FontHandle handle, const char *text, Vector2 position, float fontSize, float spacing, Color tint)
+{
+    ResourceSlot *slot = FindSlot(handle, RESOURCE_FONT);
+    if (slot != NULL) slot->drawn = true;
+    DrawSdfText((slot != NULL) ? slot->font : GetFontDefault(), text, position, fontSize, spacing, tint);
+}
+
+Vector2 MeasureFontText(FontHandle handle, const char *text, float fontSize, float spacing)
+{
+    ResourceSlot *slot = FindSlot(handle, RESOURCE_FONT);
+    return MeasureTextEx((slot != NULL) ? slot->font : GetFontDefault(), text, fontSize, spacing);
+}
+
+void TrackSound(const char *name, Sound sound, double loadSeconds)
+{
+    bool existing;
+    int index = ClaimSlot(name, RESOURCE_SOUND, &existing);
+    if (index < 0 || existing) return;
+
+    // Sounds are converted to the mixer format on load and played from system memory
+    size_t bytes = (size_t)sound.frameCount * sound.stream.channels * (sound.stream.sampleSize / 8);
+    FillSlot(index, name, RESOURCE_SOUND, bytes, 0, loadSeconds, false);
+}
+
+void TrackMusic(const char *name, Music music, int bufferFrames, double loadSeconds)
+{
+    bool existing;
+    int index = ClaimSlot(name, RESOURCE_MUSIC, &existing);
+    if (index < 0 || existing) return;
+
+    // Streamed: only the two sub-buffers the decoder refills stay resident
+    size_t bytes = 2 * (size_t)bufferFrames * music.stream.channels * (music.stream.sampleSize / 8);
+    FillSlot(index, name, RESOURCE_MUSIC, bytes, 0, loadSeconds, false);
+}
+
+void UnloadResources(void)
+{
+    for (int i = 0; i < RESOURCES_MAX; i++) {
+        ResourceSlot *slot = &slots[i];
+        if (!slot->loaded) continue;
+
+        if (slot->owned && slot->references > 0)
+            TraceLog(LOG_DEBUG, "RESOURCES: [%s] Still referenced %d times at unload", slot->path, slot->references);
+        if (slot->owned && slot->category == RESOURCE_TEXTURE) UnloadTexture(slot->texture);
+        if (slot->owned && slot->category == RESOURCE_FONT) UnloadFont(slot->font);
+
+        slot->texture = (Texture2D){ 0 };
+        slot->font = (Font){ 0 };
+        slot->references = 0;
+        slot->loaded = false;
+        slot->generation++;  // Old handles to this slot go stale
+    }
+    memset(totals, 0, sizeof(totals));
+    UnloadSdfFonts();
+}
+
+const ResourceTotals *GetResourceTotals(void)
+{
+    return totals;
+}
+
+const char *GetResourceCategoryName(ResourceCategory category)
+{
+    return categoryNames[category];
+}
+
+int GetUndrawnResources(const char **names, int maxNames)
+{
+    int count = 0;
+    for (int i = 0; i < RESOURCES_MAX; i++) {
+        const ResourceSlot *slot = &slots[i];
+        if (!slot->loaded || slot->drawn || (slot->category != RESOURCE_TEXTURE && slot->category != RESOURCE_FONT)) continue;
+        if (count < maxNames) names[count] = slot->path;
+        count++;
+    }
+    return count;
+}
+
+void LogResourceReport(void)
+{
+    TraceLog(LOG_INFO, "RESOURCES: %-9s %-32s %10s %10s %9s", "kind", "asset", "cpu KB", "gpu KB", "load ms");
+    for (int i = 0; i < RESOURCES_MAX; i++) {
+        const ResourceSlot *slot = &slots[i];
+        if (!slot->loaded) continue;
+
+        bool drawable = slot->category == RESOURCE_TEXTURE || slot->category == RESOURCE_FONT;
+        TraceLog(LOG_INFO, "RESOURCES: %-9s %-32s %10.1f %10.1f %9.2f%s", categoryNames[slot->category], slot->path,
+                 slot->cpuBytes / 1024.0f, slot->gpuBytes / 1024.0f, slot->loadSeconds * 1000.0,
+                 (drawable && !slot->drawn) ? "  never drawn" : "");
+    }
+
+    size_t cpuBytes = 0, gpuBytes = 0;
+    double loadSeconds = 0.0;
+    for (int c = 0; c < RESOURCE_CATEGORY_COUNT; c++) {
+        TraceLog(LOG_INFO, "RESOURCES: %-9s %3d assets %31.1f %10.1f %9.2f", categoryNames[c], totals[c].count,
+                 totals[c].cpuBytes / 1024.0f, totals[c].gpuBytes / 1024.0f, totals[c].loadSeconds * 1000.0);
+        cpuBytes += totals[c].cpuBytes;
+        gpuBytes += totals[c].gpuBytes;
+        loadSeconds += totals[c].loadSeconds;
+    }
+    TraceLog(LOG_INFO, "RESOURCES: %-9s %42.1f %10.1f %9.2f", "total", cpuBytes / 1024.0f, gpuBytes / 1024.0f, loadSeconds * 1000.0);
+}
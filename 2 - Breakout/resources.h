@@ -0,0 +1,69 @@
+#ifndef RESOURCES_H
+#define RESOURCES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "raylib.h"
+
+/* RESOURCES */
+// Textures and fonts are loaded once per path and handed out as small
+// handles, so entities store two bytes instead of a copy of the asset.
+// Handles are reference counted, but an asset whose last user releases it
+// stays resident: acquiring it again after a restart costs no I/O or upload.
+// Everything is unloaded together by UnloadResources().
+//
+// Every asset is also accounted for: CPU and GPU bytes computed from its
+// dimensions, pixel format or sample count, and the time its load took, so
+// slow decodes show up per asset. Textures come from the texture pack when
+// it is loaded. Sounds and music stay owned by their callers and are only
+// tracked. Reading a texture through its handle or
+// drawing text with a font marks it as drawn, so the report can list what was never used.
+//
+// AcquireTextures() loads a batch: every image is decoded on the job
+// threads (see jobs.h) and only the uploads, which need the GL context,
+// run on the calling thread.
+
+#define RESOURCES_MAX 64
+#define RESOURCES_PATH_SIZE 128
+
+typedef uint16_t TextureHandle;  // Slot in the low byte, generation in the high byte
+typedef uint16_t FontHandle;
+#define INVALID_TEXTURE 0
+#define INVALID_FONT 0
+
+typedef enum {
+    RESOURCE_TEXTURE,
+    RESOURCE_FONT,
+    RESOURCE_SOUND,
+    RESOURCE_MUSIC,
+    RESOURCE_CATEGORY_COUNT,
+} ResourceCategory;
+
+typedef struct {
+    int count;
+    size_t cpuBytes;
+    size_t gpuBytes;
+    double loadSeconds;
+} ResourceTotals;
+
+TextureHandle AcquireTexture(const char *fileName);     // Loads on first use
+void AcquireTextures(TextureHandle *handles, const char **fileNames, int count);  // Decodes the new ones in parallel
+void ReleaseTexture(TextureHandle handle);
+Texture2D GetTexture(TextureHandle handle);             // Empty texture for a stale or invalid handle
+
+FontHandle AcquireFont(const char *fileName);           // One SDF atlas per typeface, drawn at any size
+void ReleaseFont(FontHandle handle);
+void DrawFontText(FontHandle handle, const char *text, Vector2 position, float fontSize, float spacing, Color tint);
+Vector2 MeasureFontText(FontHandle handle, const char *text, float fontSize, float spacing);
+
+void TrackSound(const char *name, Sound sound, double loadSeconds);  // Accounting only, the caller still owns it
+void TrackMusic(const char *name, Music music, int bufferFrames, double loadSeconds);  // Frames per stream sub-buffer
+
+void UnloadResources(void);
+
+const ResourceTotals *GetResourceTotals(void);          // Indexed by ResourceCategory
+const char *GetResourceCategoryName(ResourceCategory category);
+int GetUndrawnResources(const char **names, int maxNames);  // Textures and fonts never read since loading
+void LogResourceReport(void);
+
+#endif // RESOURCES_H
@@ -0,0 +1,142 @@
+#include "rewind.h"
+#include "delta.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Delta bytes budgeted per frame, as a fraction of a full snapshot; a group
+// that runs out early just starts a new keyframe
+#define REWIND_DELTA_RATIO 8
+
+bool InitRewind(RewindBuffer *rb, int snapshotSize, int frames, int framesPerGroup)
+{
+    memset(rb, 0, sizeof(*rb));
+    rb->snapshotSize = snapshotSize;
+    rb->framesPerGroup = framesPerGroup;
+    rb->groupCapacity = (frames + framesPerGroup - 1) / framesPerGroup + 1;
+    rb->groupBytes = framesPerGroup * (snapshotSize / REWIND_DELTA_RATIO + 4);
+
+    rb->keyframes = malloc((size_t)rb->groupCapacity * snapshotSize);
+    rb->deltas = malloc((size_t)rb->groupCapacity * rb->groupBytes);
+    rb->frames = malloc((size_t)rb->groupCapacity * framesPerGroup * sizeof(RewindFrame));
+    rb->groupFrames = calloc(rb->groupCapacity, sizeof(int));
+    rb->groupUsed = calloc(rb->groupCapacity, sizeof(int));
+
+    if (!rb->keyframes || !rb->deltas || !rb->frames || !rb->groupFrames || !rb->groupUsed) {
+        UnloadRewind(rb);
+        return false;
+    }
+    return true;
+}
+
+void UnloadRewind(RewindBuffer *rb)
+{
+    free(rb->keyframes);
+    free(rb->deltas);
+    free(rb->frames);
+    free(rb->groupFrames);
+    free(rb->groupUsed);
+    memset(rb, 0, sizeof(*rb));
+}
+
+void ClearRewind(RewindBuffer *rb)
+{
+    rb->first = 0;
+    rb->groups = 0;
+}
+
+static int GroupIndex(const RewindBuffer *rb, int n)
+{
+    return (rb->first + n) % rb->groupCapacity;
+}
+
+static void StartGroup(RewindBuffer *rb, const void *snapshot)
+{
+    if (rb->groups == rb->groupCapacity) {
+        rb->first = (rb->first + 1) % rb->groupCapacity;
+        rb->groups--;
+    }
+
+    int g = GroupIndex(rb, rb->groups++);
+    memcpy(rb->keyframes + (size_t)g * rb->snapshotSize, snapshot, rb->snapshotSize);
+    rb->frames[g * rb->framesPerGroup] = (RewindFrame){ 0, 0 };
+    rb->groupFrames[g] = 1;
+    rb->groupUsed[g] = 0;
+}
+
+void RewindPush(RewindBuffer *rb, const void *snapshot)
+{
+    if (rb->keyframes == NULL) return;
+
+    if (rb->groups == 0) {
+        StartGroup(rb, snapshot);
+        return;
+    }
+
+    int g = GroupIndex(rb, rb->groups - 1);
+    if (rb->groupFrames[g] == rb->framesPerGroup) {
+        StartGroup(rb, snapshot);
+        return;
+    }
+
+    unsigned char *out = rb->deltas + (size_t)g * rb->groupBytes + rb->groupUsed[g];
+    int length = DeltaEncode(rb->keyframes + (size_t)g * rb->snapshotSize, snapshot, rb->snapshotSize,
+                             out, rb->groupBytes - rb->groupUsed[g]);
+    if (length < 0) {
+        StartGroup(rb, snapshot);
+        return;
+    }
+
+    rb->frames[g * rb->framesPerGroup + rb->groupFrames[g]] = (RewindFrame){ rb->groupUsed[g], length };
+    rb->groupFrames[g]++;
+    rb->groupUsed[g] += length;
+}
+
+int RewindFrameCount(const RewindBuffer *rb)
+{
+    int count = 0;
+    for (int n = 0; n < rb->groups; n++) count += rb->groupFrames[GroupIndex(rb, n)];
+    return count;
+}
+
+bool RewindGet(const RewindBuffer *rb, int framesAgo, void *out)
+{
+    for (int n = rb->groups - 1; n >= 0 && framesAgo >= 0; n--) {
+        int g = GroupIndex(rb, n);
+        if (framesAgo < rb->groupFrames[g]) {
+            int index = rb->groupFrames[g] - 1 - framesAgo;
+            const unsigned char *keyframe = rb->keyframes + (size_t)g * rb->snapshotSize;
+            if (index == 0) {
+                memcpy(out, keyframe, rb->snapshotSize);
+                return true;
+            }
+            RewindFrame frame = rb->frames[g * rb->framesPerGroup + index];
+            return DeltaDecode(keyframe, rb->deltas + (size_t)g * rb->groupBytes + frame.offset,
+                               frame.length, out, rb->snapshotSize);
+        }
+        framesAgo -= rb->groupFrames[g];
+    }
+    return false;
+}
+
+void RewindDrop(RewindBuffer *rb, int frames)
+{
+    while (frames > 0 && rb->groups > 0) {
+        int g = GroupIndex(rb, rb->groups - 1);
+        if (frames >= rb->groupFrames[g]) {
+            frames -= rb->groupFrames[g];
+            rb->groups--;
+            continue;
+        }
+
+        rb->groupFrames[g] -= frames;
+        RewindFrame last = rb->frames[g * rb->framesPerGroup + rb->groupFrames[g] - 1];
+        rb->groupUsed[g] = last.offset + last.length;
+        frames = 0;
+    }
+}
+
+int RewindMemoryUsage(const RewindBuffer *rb)
+{
+    return rb->groupCapacity * (rb->snapshotSize + rb->groupBytes +
+                                rb->framesPerGroup * (int)sizeof(RewindFrame) + 2 * (int)sizeof(int));
+}
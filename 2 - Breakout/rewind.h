@@ -0,0 +1,42 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include "stdbool.h"
+
+/* REWIND */
+// Ring of per-tick snapshots split into groups: each group starts with a full
+// keyframe and stores the following frames as deltas against it, so any frame
+// decodes with a single DeltaDecode(). All memory is allocated up front; when
+// the ring is full the oldest group is overwritten.
+
+typedef struct {
+    int offset;
+    int length;
+} RewindFrame;
+
+typedef struct {
+    int snapshotSize;
+    int framesPerGroup;
+    int groupCapacity;
+    int groupBytes;
+
+    unsigned char *keyframes;  // groupCapacity * snapshotSize
+    unsigned char *deltas;     // groupCapacity * groupBytes
+    RewindFrame *frames;       // groupCapacity * framesPerGroup
+    int *groupFrames;
+    int *groupUsed;
+
+    int first;   // oldest group
+    int groups;  // groups in use
+} RewindBuffer;
+
+bool InitRewind(RewindBuffer *rb, int snapshotSize, int frames, int framesPerGroup);
+void UnloadRewind(RewindBuffer *rb);
+void ClearRewind(RewindBuffer *rb);
+void RewindPush(RewindBuffer *rb, const void *snapshot);
+int RewindFrameCount(const RewindBuffer *rb);
+bool RewindGet(const RewindBuffer *rb, int framesAgo, void *out);  // 0 is the newest frame
+void RewindDrop(RewindBuffer *rb, int frames);                     // Forget the newest frames
+int RewindMemoryUsage(const RewindBuffer *rb);
+
+#endif // REWIND_H
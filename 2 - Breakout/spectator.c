@@ -0,0 +1,302 @@
+#include "spectator.h"
+#include "delta.h"
+#include "net.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Stream layout: [u32 payload size][u8 type][payload], little-endian
+#define SPECTATOR_MSG_KEYFRAME 1
+#define SPECTATOR_MSG_DELTA    2
+#define SPECTATOR_HEADER_SIZE  5
+
+typedef struct {
+    NetSocket sock;
+    unsigned char *queue;
+    int start;
+    int length;
+    bool needsKeyframe;
+} SpectatorClient;
+
+static struct {
+    SpectatorMode mode;
+    int snapshotSize;
+    int messageCapacity;
+    int queueCapacity;
+    NetSocket sock;  // Listener on the server, connection on the client
+
+    SpectatorClient clients[SPECTATOR_MAX_CLIENTS];
+    unsigned char *current;   // Last broadcast (server) or last applied (client) snapshot
+    unsigned char *scratch;
+    unsigned char *message;
+    bool hasCurrent;
+
+    int inboxLength;
+
+    SpectatorStats stats;
+} spec = { 0 };
+
+static void PutU32(unsigned char *p, uint32_t v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static uint32_t GetU32(const unsigned char *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool ParseSpectatorArgs(int argc, char *argv[], SpectatorConfig *config)
+{
+    memset(config, 0, sizeof(*config));
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            config->mode = SPECTATOR_SERVER;
+            config->port = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--spectate") == 0 && i + 2 < argc) {
+            config->mode = SPECTATOR_CLIENT;
+            snprintf(config->host, sizeof(config->host), "%s", argv[i + 1]);
+            config->port = atoi(argv[i + 2]);
+            i += 2;
+        }
+    }
+
+    return config->mode != SPECTATOR_OFF;
+}
+
+bool InitSpectator(const SpectatorConfig *config, int snapshotSize)
+{
+    if (config->mode == SPECTATOR_OFF || !InitNet()) return false;
+
+    spec.snapshotSize = snapshotSize;
+    // Room for a delta a bit larger than the snapshot; past that a keyframe is cheaper
+    spec.messageCapacity = SPECTATOR_HEADER_SIZE + snapshotSize + snapshotSize / 2 + 64;
+    spec.queueCapacity = 4 * spec.messageCapacity + 16 * 1024;
+    spec.current = calloc(1, snapshotSize);
+    spec.scratch = calloc(1, snapshotSize);
+    spec.message = malloc(spec.messageCapacity * 2);  // Client inbox holds two messages
+    spec.hasCurrent = false;
+    spec.inboxLength = 0;
+    memset(&spec.stats, 0, sizeof(spec.stats));
+    for (int i = 0; i < SPECTATOR_MAX_CLIENTS; i++) spec.clients[i].sock = NET_INVALID_SOCKET;
+
+    if (config->mode == SPECTATOR_SERVER) {
+        spec.sock = NetListenTcp(config->port);
+        if (spec.sock == NET_INVALID_SOCKET) {
+            TraceLog(LOG_WARNING, "SPECTATOR: Could not listen on TCP port %d", config->port);
+        } else {
+            // Client queues are allocated up front so gameplay never touches the heap
+            for (int i = 0; i < SPECTATOR_MAX_CLIENTS; i++) spec.clients[i].queue = malloc(spec.queueCapacity);
+            TraceLog(LOG_INFO, "SPECTATOR: Broadcasting on TCP port %d", config->port);
+        }
+    } else {
+        NetAddress address;
+        spec.sock = NET_INVALID_SOCKET;
+        if (NetResolve(config->host, config->port, &address)) spec.sock = NetConnectTcp(address);
+        if (spec.sock == NET_INVALID_SOCKET) {
+            TraceLog(LOG_WARNING, "SPECTATOR: Could not connect to %s:%d", config->host, config->port);
+        } else {
+            spec.stats.connected = true;
+            TraceLog(LOG_INFO, "SPECTATOR: Watching %s:%d", config->host, config->port);
+        }
+    }
+
+    if (spec.sock == NET_INVALID_SOCKET) {
+        CloseSpectator();
+        return false;
+    }
+    spec.mode = config->mode;
+    return true;
+}
+
+static void DropClient(SpectatorClient *client)
+{
+    NetCloseSocket(client->sock);
+    client->sock = NET_INVALID_SOCKET;
+    client->start = 0;
+    client->length = 0;
+    spec.stats.clients--;
+    spec.stats.dropped++;
+}
+
+void CloseSpectator(void)
+{
+    for (int i = 0; i < SPECTATOR_MAX_CLIENTS; i++) {
+        if (spec.clients[i].sock != NET_INVALID_SOCKET) NetCloseSocket(spec.clients[i].sock);
+        spec.clients[i].sock = NET_INVALID_SOCKET;
+        free(spec.clients[i].queue);
+        spec.clients[i].queue = NULL;
+    }
+    if (spec.sock != NET_INVALID_SOCKET) NetCloseSocket(spec.sock);
+    spec.sock = NET_INVALID_SOCKET;
+
+    free(spec.current);
+    free(spec.scratch);
+    free(spec.message);
+    spec.current = spec.scratch = spec.message = NULL;
+
+    if (spec.mode != SPECTATOR_OFF) CloseNet();
+    spec.mode = SPECTATOR_OFF;
+}
+
+SpectatorMode GetSpectatorMode(void)
+{
+    return spec.mode;
+}
+
+const SpectatorStats *GetSpectatorStats(void)
+{
+    return &spec.stats;
+}
+
+static void AcceptClients(void)
+{
+    NetSocket sock;
+    while ((sock = NetAccept(spec.sock)) != NET_INVALID_SOCKET) {
+        SpectatorClient *slot = NULL;
+        for (int i = 0; i < SPECTATOR_MAX_CLIENTS && slot == NULL; i++) {
+            if (spec.clients[i].sock == NET_INVALID_SOCKET) slot = &spec.clients[i];
+        }
+        if (slot == NULL) {
+            NetCloseSocket(sock);
+            continue;
+        }
+
+        slot->sock = sock;
+        slot->start = 0;
+        slot->length = 0;
+        slot->needsKeyframe = true;
+        spec.stats.clients++;
+    }
+}
+
+static bool Enqueue(SpectatorClient *client, const void *header, int headerSize, const void *payload, int payloadSize)
+{
+    int size = headerSize + payloadSize;
+    if (client->length + size > spec.queueCapacity) return false;  // Consumer too slow, give up on it
+
+    if (client->start + client->length + size > spec.queueCapacity) {
+        memmove(client->queue, client->queue + client->start, client->length);
+        client->start = 0;
+    }
+    unsigned char *end = client->queue + client->start + client->length;
+    memcpy(end, header, headerSize);
+    if (payloadSize > 0) memcpy(end + headerSize, payload, payloadSize);
+    client->length += size;
+    return true;
+}
+
+static bool Flush(SpectatorClient *client)
+{
+    while (client->length > 0) {
+        int sent = NetSend(client->sock, client->queue + client->start, client->length);
+        if (sent < 0) return false;
+        if (sent == 0) break;
+        client->start += sent;
+        client->length -= sent;
+    }
+    if (client->length == 0) client->start = 0;
+    return true;
+}
+
+void BroadcastSnapshot(const void *snapshot)
+{
+    if (spec.mode != SPECTATOR_SERVER) return;
+
+    AcceptClients();
+
+    // One encode per tick, shared by every client
+    int deltaSize = -1;
+    if (spec.hasCurrent) {
+        deltaSize = DeltaEncode(spec.current, snapshot, spec.snapshotSize,
+                                spec.message + SPECTATOR_HEADER_SIZE, spec.messageCapacity - SPECTATOR_HEADER_SIZE);
+        PutU32(spec.message, (uint32_t)(deltaSize > 0 ? deltaSize : 0));
+        spec.message[4] = SPECTATOR_MSG_DELTA;
+    }
+    memcpy(spec.current, snapshot, spec.snapshotSize);
+    spec.hasCurrent = true;
+    spec.stats.lastMessage = (deltaSize < 0) ? spec.snapshotSize : deltaSize;
+
+    unsigned char keyframeHeader[SPECTATOR_HEADER_SIZE];
+    PutU32(keyframeHeader, (uint32_t)spec.snapshotSize);
+    keyframeHeader[4] = SPECTATOR_MSG_KEYFRAME;
+
+    for (int i = 0; i < SPECTATOR_MAX_CLIENTS; i++) {
+        SpectatorClient *client = &spec.clients[i];
+        if (client->sock == NET_INVALID_SOCKET) continue;
+
+        bool ok = true;
+        if (client->needsKeyframe || deltaSize < 0) {
+            ok = Enqueue(client, keyframeHeader, SPECTATOR_HEADER_SIZE, snapshot, spec.snapshotSize);
+            client->needsKeyframe = false;
+        } else if (deltaSize > 0) {
+            ok = Enqueue(client, spec.message, SPECTATOR_HEADER_SIZE + deltaSize, NULL, 0);
+        }
+
+        if (!ok || !Flush(client)) DropClient(client);
+    }
+}
+
+bool ReceiveSnapshot(void *snapshot)
+{
+    if (spec.mode != SPECTATOR_CLIENT || !spec.stats.connected) return false;
+
+    unsigned char *inbox = spec.message;
+    int inboxCapacity = spec.messageCapacity * 2;
+    bool changed = false;
+
+    while (spec.stats.connected) {
+        int received = 0;
+        if (spec.inboxLength < inboxCapacity) {
+            received = NetReceive(spec.sock, inbox + spec.inboxLength, inboxCapacity - spec.inboxLength);
+            if (received < 0) {
+                TraceLog(LOG_WARNING, "SPECTATOR: Stream closed");
+                spec.stats.connected = false;
+                break;
+            }
+            spec.inboxLength += received;
+        }
+
+        int pos = 0;
+        while (spec.inboxLength - pos >= SPECTATOR_HEADER_SIZE) {
+            // Checked while still unsigned, a length past INT_MAX would turn negative as an int
+            uint32_t length = GetU32(inbox + pos);
+            int type = inbox[pos + 4];
+            if (length > (uint32_t)(spec.messageCapacity - SPECTATOR_HEADER_SIZE) ||
+                (type == SPECTATOR_MSG_KEYFRAME && length != (uint32_t)spec.snapshotSize)) {
+                TraceLog(LOG_WARNING, "SPECTATOR: Stream does not match this build, disconnecting");
+                spec.stats.connected = false;
+                break;
+            }
+            int size = (int)length;
+            if (spec.inboxLength - pos < SPECTATOR_HEADER_SIZE + size) break;
+
+            const unsigned char *payload = inbox + pos + SPECTATOR_HEADER_SIZE;
+            if (type == SPECTATOR_MSG_KEYFRAME) {
+                memcpy(spec.current, payload, size);
+                spec.hasCurrent = true;
+                changed = true;
+            } else if (type == SPECTATOR_MSG_DELTA && spec.hasCurrent) {
+                if (DeltaDecode(spec.current, payload, size, spec.scratch, spec.snapshotSize)) {
+                    unsigned char *swap = spec.current;
+                    spec.current = spec.scratch;
+                    spec.scratch = swap;
+                    changed = true;
+                }
+            }
+            pos += SPECTATOR_HEADER_SIZE + size;
+        }
+
+        memmove(inbox, inbox + pos, spec.inboxLength - pos);
+        spec.inboxLength -= pos;
+        if (received == 0) break;
+    }
+
+    if (changed) memcpy(snapshot, spec.current, spec.snapshotSize);
+    return changed;
+}
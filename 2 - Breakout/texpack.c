@@ -0,0 +1,84 @@
+#include "texpack.h"
+#include <string.h>
+
+static unsigned char *packData = NULL;
+static const TexPackEntry *entries = NULL;
+static const unsigned char *pixels = NULL;
+static uint32_t pixelsSize = 0;
+static uint32_t entryCount = 0;
+
+bool LoadTexturePack(const char *fileName)
+{
+    UnloadTexturePack();
+
+    int size = 0;
+    unsigned char *data = LoadFileData(fileName, &size);
+    if (data == NULL) return false;
+
+    TexPackHeader header;
+    if ((size_t)size < sizeof(header)) goto invalid;
+    memcpy(&header, data, sizeof(header));
+
+    size_t tableEnd = sizeof(header) + (size_t)header.count * sizeof(TexPackEntry);
+    if (header.magic != TEXPACK_MAGIC || header.version != TEXPACK_VERSION ||
+        tableEnd > (size_t)size || (size_t)size - tableEnd != header.dataSize) goto invalid;
+
+    packData = data;
+    entries = (const TexPackEntry *)(data + sizeof(header));
+    pixels = data + tableEnd;
+    pixelsSize = header.dataSize;
+    entryCount = header.count;
+    TraceLog(LOG_INFO, "TEXPACK: [%s] %u textures, %d KB", fileName, entryCount, size / 1024);
+    return true;
+
+invalid:
+    TraceLog(LOG_WARNING, "TEXPACK: [%s] Invalid or outdated pack, run 'make textures'", fileName);
+    UnloadFileData(data);
+    return false;
+}
+
+void UnloadTexturePack(void)
+{
+    if (packData != NULL) UnloadFileData(packData);
+    packData = NULL;
+    entries = NULL;
+    pixels = NULL;
+    pixelsSize = 0;
+    entryCount = 0;
+}
+
+Image LoadPackedImage(const char *fileName, bool *fromPack)
+{
+    *fromPack = false;
+    for (uint32_t i = 0; i < entryCount; i++) {
+        const TexPackEntry *entry = &entries[i];
+        if (strncmp(entry->name, fileName, TEXPACK_NAME_SIZE) != 0) continue;
+
+        uint32_t expected = (uint32_t)GetPixelDataSize(entry->width, entry->height, entry->format);
+        if (entry->mipmaps != 1 || entry->size != expected ||
+            entry->offset > pixelsSize || entry->size > pixelsSize - entry->offset) break;
+
+        // The pack outlives the upload, so the image can point into it
+        *fromPack = true;
+        return (Image){
+            .data = (void *)(pixels + entry->offset),
+            .width = entry->width,
+            .height = entry->height,
+            .mipmaps = entry->mipmaps,
+            .format = entry->format,
+        };
+    }
+
+    return LoadImage(fileName);
+}
+
+Texture2D LoadPackedTexture(const char *fileName)
+{
+    bool fromPack;
+    Image image = LoadPackedImage(fileName, &fromPack);
+    if (image.data == NULL) return (Texture2D){ 0 };
+
+    Texture2D texture = LoadTextureFromImage(image);
+    if (!fromPack) UnloadImage(image);
+    return texture;
+}
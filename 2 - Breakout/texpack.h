@@ -0,0 +1,43 @@
+#ifndef TEXPACK_H
+#define TEXPACK_H
+
+#include <stdint.h>
+#include "raylib.h"
+
+/* TEXTURE PACK */
+// Images cooked offline by tools/texcook into raw pixels already in the
+// format the GPU is given, so startup uploads them straight from the pack
+// instead of inflating and unfiltering PNGs.
+// Layout: TexPackHeader, count TexPackEntry, then the pixel data.
+
+#define TEXPACK_MAGIC 0x4B415054u  // "TPAK"
+#define TEXPACK_VERSION 1
+#define TEXPACK_NAME_SIZE 64
+#define TEXPACK_ALIGNMENT 4        // Pixel rows start on a word
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t dataSize;
+} TexPackHeader;
+
+typedef struct {
+    char name[TEXPACK_NAME_SIZE];  // Path the game loads it by, e.g. "res/pipe.png"
+    uint32_t offset;               // From the start of the data block
+    uint32_t size;                 // Bytes, every mip level included
+    uint16_t width;
+    uint16_t height;
+    uint16_t format;               // raylib PixelFormat
+    uint16_t mipmaps;
+} TexPackEntry;
+
+bool LoadTexturePack(const char *fileName);
+void UnloadTexturePack(void);                       // Once every texture is uploaded
+Texture2D LoadPackedTexture(const char *fileName);  // Uploaded from the pack if packed, otherwise decodes fileName
+
+// The CPU half of LoadPackedTexture(), safe on any thread. With *fromPack the
+// pixels point into the pack, otherwise they were decoded and need UnloadImage()
+Image LoadPackedImage(const char *fileName, bool *fromPack);
+
+#endif // TEXPACK_H
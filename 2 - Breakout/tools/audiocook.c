@@ -0,0 +1,136 @@
+// Offline audio cooker: decodes sound effects and converts them to the mixer
+// format, writing a single pack the game can load without decoding.
+//
+//   audiocook [--check <source.c>]... <output.pak> <sound files...>
+//
+// Fails if any input is missing or cannot be decoded. --check also scans a
+// source file for audio paths in string literals (music included, which is
+// streamed rather than packed) and fails if any of them does not exist.
+
+#include "audiopack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool IsAudioPath(const char *path, int length)
+{
+    static const char *extensions[] = { ".wav", ".mp3", ".ogg", ".flac", ".qoa" };
+    for (int i = 0; i < (int)(sizeof(extensions) / sizeof(extensions[0])); i++) {
+        int n = (int)strlen(extensions[i]);
+        if (length > n && strncmp(path + length - n, extensions[i], n) == 0) return true;
+    }
+    return false;
+}
+
+// Missing audio files referenced as "..." literals in a source file
+static int CheckSource(const char *sourceName)
+{
+    char *text = LoadFileText(sourceName);
+    if (text == NULL) {
+        fprintf(stderr, "audiocook: cannot read %s\n", sourceName);
+        return 1;
+    }
+
+    int missing = 0;
+    for (char *start = strchr(text, '"'); start != NULL; ) {
+        char *end = strchr(start + 1, '"');
+        if (end == NULL) break;
+
+        int length = (int)(end - start - 1);
+        if (length < 256 && IsAudioPath(start + 1, length)) {
+            char path[256];
+            memcpy(path, start + 1, length);
+            path[length] = '\0';
+            if (!FileExists(path)) {
+                fprintf(stderr, "audiocook: %s references missing %s\n", sourceName, path);
+                missing++;
+            }
+        }
+        start = strchr(end + 1, '"');
+    }
+
+    UnloadFileText(text);
+    return missing;
+}
+
+int main(int argc, char *argv[])
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    int failed = 0;
+    int first = 1;
+    while (first + 1 < argc && strcmp(argv[first], "--check") == 0) {
+        failed += CheckSource(argv[first + 1]);
+        first += 2;
+    }
+
+    if (argc - first < 2) {
+        fprintf(stderr, "usage: %s [--check <source.c>]... <output.pak> <sound files...>\n", argv[0]);
+        return 1;
+    }
+
+    const char *outputName = argv[first];
+    char **inputs = argv + first + 1;
+    int count = argc - first - 1;
+    AudioPackEntry *entries = calloc(count, sizeof(AudioPackEntry));
+    Wave *waves = calloc(count, sizeof(Wave));
+    uint32_t dataSize = 0;
+
+    for (int i = 0; i < count; i++) {
+        const char *fileName = inputs[i];
+
+        if (!FileExists(fileName)) {
+            fprintf(stderr, "audiocook: missing %s\n", fileName);
+            failed++;
+            continue;
+        }
+        if (strlen(fileName) >= AUDIOPACK_NAME_SIZE) {
+            fprintf(stderr, "audiocook: path too long %s\n", fileName);
+            failed++;
+            continue;
+        }
+
+        waves[i] = LoadWave(fileName);
+        if (!IsWaveValid(waves[i])) {
+            fprintf(stderr, "audiocook: cannot decode %s\n", fileName);
+            failed++;
+            continue;
+        }
+        WaveFormat(&waves[i], AUDIOPACK_SAMPLE_RATE, AUDIOPACK_SAMPLE_SIZE, AUDIOPACK_CHANNELS);
+
+        AudioPackEntry *entry = &entries[i];
+        strncpy(entry->name, fileName, AUDIOPACK_NAME_SIZE - 1);
+        entry->offset = dataSize;
+        entry->frameCount = waves[i].frameCount;
+        entry->sampleRate = waves[i].sampleRate;
+        entry->sampleSize = (uint16_t)waves[i].sampleSize;
+        entry->channels = (uint16_t)waves[i].channels;
+        dataSize += waves[i].frameCount * waves[i].channels * (waves[i].sampleSize / 8);
+    }
+
+    if (failed == 0) {
+        FILE *file = fopen(outputName, "wb");
+        if (file == NULL) {
+            fprintf(stderr, "audiocook: cannot write %s\n", outputName);
+            failed++;
+        } else {
+            AudioPackHeader header = { AUDIOPACK_MAGIC, AUDIOPACK_VERSION, (uint32_t)count, dataSize };
+            fwrite(&header, sizeof(header), 1, file);
+            fwrite(entries, sizeof(AudioPackEntry), count, file);
+            for (int i = 0; i < count; i++) {
+                fwrite(waves[i].data, 1, waves[i].frameCount * waves[i].channels * (waves[i].sampleSize / 8), file);
+            }
+            if (fclose(file) != 0) {
+                remove(outputName);
+                failed++;
+            } else {
+                printf("audiocook: %d sounds, %u KB -> %s\n", count, dataSize / 1024, outputName);
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++) UnloadWave(waves[i]);
+    free(waves);
+    free(entries);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+// Offline level compiler: turns the text level sources into the binary pack
+// the game maps at startup, with brick cells, tiers, colors and sprite
+// indices already resolved.
+//
+//   levelcook <output.lvl> <level files...>
+//
+// Source format, one or more levels per file, played in file then source order:
+//
+//   # comment
+//   level Name Of The Level
+//   31 31 .  31 31
+//   20 40 22* 40 20
+//
+// Each line after 'level' is one row of bricks. A cell is '.' for no brick or
+// <color 1-5><tier 0-3>, with a trailing '*' for the locked brick. Every row
+// of a level has the same number of cells. Fails on the first malformed line.
+
+#include "levelpack.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    char name[LEVELPACK_NAME_SIZE];
+    int brickCount;
+    int cols, rows;
+    LevelBrick bricks[LEVELPACK_MAX_BRICKS];
+} LevelSource;
+
+static LevelSource *levels = NULL;
+static int levelCount = 0;
+static int levelCapacity = 0;
+
+static int Fail(const char *fileName, int line, const char *message)
+{
+    fprintf(stderr, "levelcook: %s:%d: %s\n", fileName, line, message);
+    return 1;
+}
+
+static LevelSource *AddLevel(const char *name)
+{
+    if (levelCount == levelCapacity) {
+        levelCapacity = (levelCapacity == 0) ? 16 : levelCapacity * 2;
+        levels = realloc(levels, levelCapacity * sizeof(LevelSource));
+        if (levels == NULL) {
+            fprintf(stderr, "levelcook: out of memory\n");
+            exit(1);
+        }
+    }
+
+    LevelSource *level = &levels[levelCount++];
+    memset(level, 0, sizeof(*level));
+    snprintf(level->name, sizeof(level->name), "%s", name);
+    return level;
+}
+
+// A level without rows has nothing to play
+static int FinishLevel(const char *fileName, int line, const LevelSource *level)
+{
+    if (level != NULL && level->rows == 0) return Fail(fileName, line, "level has no rows");
+    return 0;
+}
+
+static int CookFile(const char *fileName)
+{
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL) {
+        fprintf(stderr, "levelcook: cannot read %s\n", fileName);
+        return 1;
+    }
+
+    char text[512];
+    int line = 0;
+    int failed = 0;
+    LevelSource *level = NULL;
+
+    while (!failed && fgets(text, sizeof(text), file) != NULL) {
+        line++;
+        text[strcspn(text, "\r\n")] = '\0';
+
+        char *start = text;
+        while (isspace((unsigned char)*start)) start++;
+        if (*start == '\0' || *start == '#') continue;
+
+        if (strncmp(start, "level", 5) == 0 && (start[5] == '\0' || isspace((unsigned char)start[5]))) {
+            failed = FinishLevel(fileName, line, level);
+            char *name = start + 5;
+            while (isspace((unsigned char)*name)) name++;
+            level = AddLevel(name);
+            continue;
+        }
+
+        if (level == NULL) {
+            failed = Fail(fileName, line, "row before the first 'level' line");
+            break;
+        }
+        if (level->rows == LEVELPACK_MAX_ROWS) {
+            failed = Fail(fileName, line, "too many rows");
+            break;
+        }
+
+        int row = level->rows;
+        int col = 0;
+        for (char *cell = strtok(start, " \t"); cell != NULL && !failed; cell = strtok(NULL, " \t"), col++) {
+            if (col == LEVELPACK_MAX_COLS) {
+                failed = Fail(fileName, line, "too many cells in row");
+                break;
+            }
+            if (strcmp(cell, ".") == 0) continue;
+
+            size_t length = strlen(cell);
+            bool locked = (length == 3 && cell[2] == '*');
+            if ((length != 2 && !locked) || cell[0] < '1' || cell[0] > '5' || cell[1] < '0' || cell[1] > '3') {
+                failed = Fail(fileName, line, "cell must be '.' or <color 1-5><tier 0-3>[*]");
+                break;
+            }
+            if (level->brickCount == LEVELPACK_MAX_BRICKS) {
+                failed = Fail(fileName, line, "too many bricks in level");
+                break;
+            }
+
+            int color = cell[0] - '0';
+            int tier = cell[1] - '0';
+            level->bricks[level->brickCount++] = (LevelBrick){
+                .col = (uint8_t)col,
+                .row = (uint8_t)row,
+                .color = (uint8_t)color,
+                .tier = (uint8_t)tier,
+                .spriteIndex = (uint8_t)(tier * 5 + (color - 1)),
+                .flags = locked ? LEVELPACK_BRICK_LOCKED : 0,
+            };
+        }
+        if (failed) break;
+
+        if (row == 0) {
+            level->cols = col;
+        } else if (col != level->cols) {
+            failed = Fail(fileName, line, "row length differs from the first row");
+            break;
+        }
+        level->rows++;
+    }
+
+    if (!failed) failed = FinishLevel(fileName, line, level);
+    fclose(file);
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output.lvl> <level files...>\n", argv[0]);
+        return 1;
+    }
+
+    const char *outputName = argv[1];
+    for (int i = 2; i < argc; i++) {
+        if (CookFile(argv[i]) != 0) {
+            free(levels);
+            return 1;
+        }
+    }
+
+    // Records are variable length; the offset table makes each one a direct lookup
+    uint32_t *offsets = calloc(levelCount > 0 ? levelCount : 1, sizeof(uint32_t));
+    uint32_t dataSize = 0;
+    for (int i = 0; i < levelCount; i++) {
+        offsets[i] = dataSize;
+        dataSize += (uint32_t)(sizeof(LevelRecord) + levels[i].brickCount * sizeof(LevelBrick));
+    }
+
+    int failed = 0;
+    FILE *file = fopen(outputName, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "levelcook: cannot write %s\n", outputName);
+        failed++;
+    } else {
+        LevelPackHeader header = { LEVELPACK_MAGIC, LEVELPACK_VERSION, (uint32_t)levelCount, dataSize };
+        fwrite(&header, sizeof(header), 1, file);
+        fwrite(offsets, sizeof(uint32_t), levelCount, file);
+        for (int i = 0; i < levelCount; i++) {
+            LevelRecord record = { .brickCount = (uint16_t)levels[i].brickCount,
+                                   .cols = (uint8_t)levels[i].cols, .rows = (uint8_t)levels[i].rows };
+            memcpy(record.name, levels[i].name, LEVELPACK_NAME_SIZE);
+            fwrite(&record, sizeof(LevelRecord), 1, file);
+            fwrite(levels[i].bricks, sizeof(LevelBrick), levels[i].brickCount, file);
+        }
+        if (fclose(file) != 0) {
+            remove(outputName);
+            failed++;
+        } else {
+            printf("levelcook: %d levels, %u bytes -> %s\n", levelCount, dataSize, outputName);
+        }
+    }
+
+    free(offsets);
+    free(levels);
+    return failed ? 1 : 0;
+}
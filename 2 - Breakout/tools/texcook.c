@@ -0,0 +1,92 @@
+// Offline texture cooker: decodes images and converts them to 8-bit RGBA,
+// writing a single pack the game can upload without decoding.
+//
+//   texcook <output.pak> <image files...>
+//
+// Fails if any input is missing or cannot be decoded.
+
+#include "texpack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char *argv[])
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output.pak> <image files...>\n", argv[0]);
+        return 1;
+    }
+
+    const char *outputName = argv[1];
+    char **inputs = argv + 2;
+    int count = argc - 2;
+    TexPackEntry *entries = calloc(count, sizeof(TexPackEntry));
+    Image *images = calloc(count, sizeof(Image));
+    uint32_t dataSize = 0;
+    int failed = 0;
+
+    for (int i = 0; i < count; i++) {
+        const char *fileName = inputs[i];
+
+        if (!FileExists(fileName)) {
+            fprintf(stderr, "texcook: missing %s\n", fileName);
+            failed++;
+            continue;
+        }
+        if (strlen(fileName) >= TEXPACK_NAME_SIZE) {
+            fprintf(stderr, "texcook: path too long %s\n", fileName);
+            failed++;
+            continue;
+        }
+
+        images[i] = LoadImage(fileName);
+        if (!IsImageValid(images[i]) || images[i].width > UINT16_MAX || images[i].height > UINT16_MAX) {
+            fprintf(stderr, "texcook: cannot decode %s\n", fileName);
+            failed++;
+            continue;
+        }
+
+        // Pixel art: one level, and no block compression to smear the edges
+        ImageFormat(&images[i], PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+        TexPackEntry *entry = &entries[i];
+        strncpy(entry->name, fileName, TEXPACK_NAME_SIZE - 1);
+        entry->offset = dataSize;
+        entry->size = (uint32_t)GetPixelDataSize(images[i].width, images[i].height, images[i].format);
+        entry->width = (uint16_t)images[i].width;
+        entry->height = (uint16_t)images[i].height;
+        entry->format = (uint16_t)images[i].format;
+        entry->mipmaps = 1;
+        dataSize += (entry->size + TEXPACK_ALIGNMENT - 1) & ~(uint32_t)(TEXPACK_ALIGNMENT - 1);
+    }
+
+    if (failed == 0) {
+        FILE *file = fopen(outputName, "wb");
+        if (file == NULL) {
+            fprintf(stderr, "texcook: cannot write %s\n", outputName);
+            failed++;
+        } else {
+            static const unsigned char padding[TEXPACK_ALIGNMENT] = { 0 };
+            TexPackHeader header = { TEXPACK_MAGIC, TEXPACK_VERSION, (uint32_t)count, dataSize };
+            fwrite(&header, sizeof(header), 1, file);
+            fwrite(entries, sizeof(TexPackEntry), count, file);
+            for (int i = 0; i < count; i++) {
+                fwrite(images[i].data, 1, entries[i].size, file);
+                fwrite(padding, 1, (TEXPACK_ALIGNMENT - entries[i].size % TEXPACK_ALIGNMENT) % TEXPACK_ALIGNMENT, file);
+            }
+            if (fclose(file) != 0) {
+                remove(outputName);
+                failed++;
+            } else {
+                printf("texcook: %d textures, %u KB -> %s\n", count, dataSize / 1024, outputName);
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++) UnloadImage(images[i]);
+    free(images);
+    free(entries);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,30 @@
+#ifndef VOICES_H
+#define VOICES_H
+
+#include "raylib.h"
+
+/* VOICES */
+// Every registered sound owns a fixed set of voices made with LoadSoundAlias(),
+// so rapid repeats overlap instead of restarting one another. A repeat with all
+// of its voices busy restarts its own oldest voice. At most VOICES_MAX_ACTIVE
+// voices play at once across all sounds; past that the oldest of the lowest
+// priority is stolen, or the new event is dropped if everything playing matters more.
+
+#define VOICES_MAX_SOUNDS 32
+#define VOICES_MAX_PER_SOUND 8
+#define VOICES_MAX_ACTIVE 12
+
+typedef enum {
+    VOICE_PRIORITY_LOW,     // Ambient, wall bounces
+    VOICE_PRIORITY_NORMAL,  // Gameplay hits
+    VOICE_PRIORITY_HIGH,    // Outcomes and UI feedback
+} VoicePriority;
+
+bool AddVoices(Sound sound, int voices, VoicePriority priority);  // Sound stays owned by the caller
+void UnloadVoices(void);                                            // Before unloading the sounds themselves
+void UpdateVoices(void);                                            // Once per frame, retires finished voices
+void PlayVoice(Sound sound);                                        // Falls back to PlaySound() if not registered
+void PlayVoicePanned(Sound sound, float balance);                   // balance: -1 left, 0 center, 1 right
+int GetActiveVoices(void);
+
+#endif // VOICES_H